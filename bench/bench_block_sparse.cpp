@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../src/block_sparse_matrix.h"
+#include "../src/morton_matrix.h"
+#include "../src/strassen.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  kSize x kSize operands where every tile is zero with probability range(0) percent.
+constexpr size_t kSize = 1024;
+
+s_fast::Matrix<double> RandomBlocks(double empty, uint32_t seed) {
+    using bench_utils::BenchmarkConstants;
+
+    constexpr size_t kTileSize = s_fast::BlockSparseMatrix<double>::kTileSize;
+
+    std::uniform_real_distribution<double> distribution(BenchmarkConstants::kMinElementValue,
+                                                        BenchmarkConstants::kMaxElementValue);
+    s_fast::Matrix<double> matrix = s_fast::Random<double>(kSize, kSize, distribution, seed);
+
+    std::mt19937 generator(seed);
+    std::bernoulli_distribution is_empty(empty);
+    for (size_t tile_row = 0; tile_row < kSize; tile_row += kTileSize) {
+        for (size_t tile_column = 0; tile_column < kSize; tile_column += kTileSize) {
+            if (!is_empty(generator)) {
+                continue;
+            }
+            for (size_t row = tile_row; row < tile_row + kTileSize; ++row) {
+                std::fill(&matrix(row, tile_column), &matrix(row, tile_column) + kTileSize, 0);
+            }
+        }
+    }
+
+    return matrix;
+}
+
+void BenchBlockSparseDense(benchmark::State& state) {
+    double empty = state.range(0) / 100.;
+    s_fast::MortonMatrix<double> a = s_fast::ToMorton(RandomBlocks(empty, 1));
+    s_fast::MortonMatrix<double> b = s_fast::ToMorton(RandomBlocks(empty, 2));
+
+    for (auto _ : state) {
+        s_fast::MortonMatrix<double> result = s_fast::Strassen(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BenchBlockSparse(benchmark::State& state) {
+    double empty = state.range(0) / 100.;
+    s_fast::BlockSparseMatrix<double> a(RandomBlocks(empty, 1));
+    s_fast::BlockSparseMatrix<double> b(RandomBlocks(empty, 2));
+
+    for (auto _ : state) {
+        s_fast::BlockSparseMatrix<double> result = s_fast::Strassen(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchBlockSparseDense)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(0)
+    ->Arg(50)
+    ->Arg(90);
+
+BENCHMARK(BenchBlockSparse)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(0)
+    ->Arg(50)
+    ->Arg(90);
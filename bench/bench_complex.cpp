@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../src/complex_multiplication.h"
+#include "bench_constants.h"
+
+namespace {
+
+template <s_fast::ComplexAlgorithm Algorithm>
+void BenchComplex(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SplitComplex;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    std::uniform_real_distribution<double> distribution(BenchmarkConstants::kMinElementValue,
+                                                        BenchmarkConstants::kMaxElementValue);
+
+    SplitComplex<double> a{Random<double>(n, m, distribution, 1),
+                           Random<double>(n, m, distribution, 2)};
+    SplitComplex<double> b{Random<double>(m, k, distribution, 3),
+                           Random<double>(m, k, distribution, 4)};
+
+    for (auto _ : state) {
+        SplitComplex<double> result = s_fast::ComplexMultiplication(a, b, Algorithm);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchComplex<s_fast::ComplexAlgorithm::kFourM>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchComplex<s_fast::ComplexAlgorithm::kThreeM>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/convolution.h"
+#include "../src/simd_multiplication.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  A 3x3 "same" layer: batch x channels x size x size input, as many filters as channels.
+constexpr int64_t kBatch = 4;
+constexpr int64_t kChannels = 64;
+constexpr int64_t kImageSize = 56;
+constexpr int64_t kKernelSize = 3;
+
+s_fast::Tensor<double> RandomTensor(int64_t batch, int64_t channels, int64_t height,
+                                    int64_t width) {
+    using bench_utils::BenchmarkConstants;
+
+    std::mt19937 random(0);
+    std::uniform_real_distribution<double> distribution(BenchmarkConstants::kMinElementValue,
+                                                        BenchmarkConstants::kMaxElementValue);
+
+    s_fast::Tensor<double> tensor(batch, channels, height, width);
+    double* data = tensor.Plane(0, 0);
+    for (int64_t i = 0; i < batch * channels * height * width; ++i) {
+        data[i] = distribution(random);
+    }
+    return tensor;
+}
+
+void BenchConv2D(benchmark::State& state) {
+    s_fast::Tensor<double> input = RandomTensor(kBatch, kChannels, kImageSize, kImageSize);
+    s_fast::Tensor<double> filters = RandomTensor(kChannels, kChannels, kKernelSize, kKernelSize);
+    s_fast::Conv2DParams same{1, 1, kKernelSize / 2, kKernelSize / 2};
+
+    for (auto _ : state) {
+        s_fast::Tensor<double> result = s_fast::Conv2D(input, filters, same);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+//  The hand written way: the whole unrolled input of every image, then SimdMultiplication.
+void BenchConv2DIm2col(benchmark::State& state) {
+    using s_fast::Matrix;
+
+    s_fast::Tensor<double> input = RandomTensor(kBatch, kChannels, kImageSize, kImageSize);
+    s_fast::Tensor<double> filters = RandomTensor(kChannels, kChannels, kKernelSize, kKernelSize);
+
+    int64_t inner = kChannels * kKernelSize * kKernelSize;
+    int64_t pixels = kImageSize * kImageSize;
+    Matrix<double> filter_matrix(kChannels, inner);
+    std::copy(filters.Plane(0, 0), filters.Plane(0, 0) + kChannels * inner,
+              filter_matrix.Data());
+
+    for (auto _ : state) {
+        for (int64_t image = 0; image < kBatch; ++image) {
+            Matrix<double> columns(inner, pixels);
+            for (int64_t c = 0; c < kChannels; ++c) {
+                for (int64_t ky = 0; ky < kKernelSize; ++ky) {
+                    for (int64_t kx = 0; kx < kKernelSize; ++kx) {
+                        int64_t row = (c * kKernelSize + ky) * kKernelSize + kx;
+                        for (int64_t y = 0; y < kImageSize; ++y) {
+                            for (int64_t x = 0; x < kImageSize; ++x) {
+                                int64_t source_y = y + ky - kKernelSize / 2;
+                                int64_t source_x = x + kx - kKernelSize / 2;
+                                if (0 <= source_y && source_y < kImageSize && 0 <= source_x &&
+                                    source_x < kImageSize) {
+                                    columns(row, y * kImageSize + x) =
+                                        input(image, c, source_y, source_x);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            Matrix<double> result = s_fast::SimdMultiplication(filter_matrix, columns);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchConv2D)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BenchConv2DIm2col)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond);
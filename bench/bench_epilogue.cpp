@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "../src/epilogue.h"
+#include "../src/packed_matrix.h"
+#include "../src/simd_multiplication.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  Linear layer: n x m inputs times m x k weights, plus bias, scale and ReLU. The inner
+//  dimension is small, so the passes over the result are a large part of the time.
+struct Layer {
+    Layer(size_t n, size_t m, size_t k)
+        : input(s_fast::Random<float>(n, m, Distribution(), 1)),
+          weights(s_fast::Random<float>(m, k, Distribution(), 2)),
+          packed(weights),
+          bias(k, 0.5f),
+          bias_matrix(n, k) {
+        for (size_t row = 0; row < n; ++row) {
+            std::copy(bias.begin(), bias.end(), &bias_matrix(row, 0));
+        }
+    }
+
+    static std::uniform_real_distribution<float> Distribution() {
+        using bench_utils::BenchmarkConstants;
+
+        return std::uniform_real_distribution<float>(BenchmarkConstants::kMinElementValue,
+                                                     BenchmarkConstants::kMaxElementValue);
+    }
+
+    s_fast::Matrix<float> input;
+    s_fast::Matrix<float> weights;
+    s_fast::PackedMatrix<float> packed;
+    std::vector<float> bias;
+    s_fast::Matrix<float> bias_matrix;
+};
+
+constexpr float kScale = 0.25f;
+
+void BenchEpilogueSeparatePasses(benchmark::State& state) {
+    Layer layer(state.range(0), state.range(1), state.range(2));
+
+    for (auto _ : state) {
+        s_fast::Matrix<float> result = s_fast::SimdMultiplication(layer.input, layer.packed);
+        result += layer.bias_matrix;
+        result *= kScale;
+        float* data = result.Data();
+        std::transform(data, data + result.Rows() * result.Columns(), data,
+                       [](float value) { return std::max(value, 0.f); });
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BenchEpilogueFused(benchmark::State& state) {
+    Layer layer(state.range(0), state.range(1), state.range(2));
+    auto epilogue =
+        s_fast::BiasColumns(layer.bias).Then(s_fast::Scale(kScale)).Then(s_fast::Relu());
+
+    for (auto _ : state) {
+        s_fast::Matrix<float> result =
+            s_fast::SimdMultiplication(layer.input, layer.packed, epilogue);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchEpilogueSeparatePasses)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({4096, 32, 2048})
+    ->Args({1024, 256, 1024});
+
+BENCHMARK(BenchEpilogueFused)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({4096, 32, 2048})
+    ->Args({1024, 256, 1024});
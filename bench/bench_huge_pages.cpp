@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../src/allocator.h"
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/simple_multiplication.h"
+#include "bench_constants.h"
+#include "perf_counters.h"
+
+namespace {
+
+//  Same multiplications with and without transparent huge pages behind every matrix. The policy
+//  is applied before the operands are allocated and restored afterwards. With
+//  S_FAST_PERF_COUNTERS set, dtlb_misses per iteration shows what the huge pages save.
+template <bool HugePages, class Multiply>
+void BenchHugePages(benchmark::State& state, Multiply multiply) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    bool enabled = s_fast::HugePagesEnabled();
+    s_fast::SetHugePages(HugePages);
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> b = Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+
+    bench_utils::PerfCounters counters;
+    counters.Start();
+    for (auto _ : state) {
+        Matrix<double> result = multiply(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+    counters.Stop();
+    counters.Report(state, bench_utils::GemmFlops(n, m, k),
+                    bench_utils::GemmBytes<double>(n, m, k));
+
+    s_fast::SetHugePages(enabled);
+}
+
+template <bool HugePages>
+void BenchHugePagesSimpleMult(benchmark::State& state) {
+    BenchHugePages<HugePages>(state, [](const auto& a, const auto& b) {
+        return s_fast::SimpleMultiplication(a, b);
+    });
+}
+
+template <bool HugePages>
+void BenchHugePagesCacheObliviousMult(benchmark::State& state) {
+    BenchHugePages<HugePages>(state, [](const auto& a, const auto& b) {
+        return s_fast::CacheObliviousMult(a, b);
+    });
+}
+
+}  // namespace
+
+BENCHMARK(BenchHugePagesSimpleMult<false>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchHugePagesSimpleMult<true>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchHugePagesCacheObliviousMult<false>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchHugePagesCacheObliviousMult<true>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
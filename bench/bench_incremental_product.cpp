@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/incremental_product.h"
+#include "../src/strassen.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  kSize x kSize operands; every iteration replaces range(0) rows of lhs.
+constexpr size_t kSize = 1024;
+
+s_fast::Matrix<double> RandomMatrix(size_t rows, size_t columns, uint32_t seed) {
+    using bench_utils::BenchmarkConstants;
+
+    std::uniform_real_distribution<double> distribution(BenchmarkConstants::kMinElementValue,
+                                                        BenchmarkConstants::kMaxElementValue);
+    return s_fast::Random<double>(rows, columns, distribution, seed);
+}
+
+void BenchIncrementalRecompute(benchmark::State& state) {
+    s_fast::Matrix<double> lhs = RandomMatrix(kSize, kSize, 1);
+    s_fast::Matrix<double> rhs = RandomMatrix(kSize, kSize, 2);
+    s_fast::Matrix<double> rows = RandomMatrix(state.range(0), kSize, 3);
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            std::copy(&rows(i, 0), &rows(i, 0) + kSize, &lhs(i * 7, 0));
+        }
+        s_fast::Matrix<double> result = s_fast::Strassen(lhs, rhs);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BenchIncrementalRows(benchmark::State& state) {
+    s_fast::IncrementalProduct<double> product(RandomMatrix(kSize, kSize, 1),
+                                               RandomMatrix(kSize, kSize, 2));
+    s_fast::Matrix<double> rows = RandomMatrix(state.range(0), kSize, 3);
+    std::vector<int64_t> indices;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        indices.push_back(i * 7);
+    }
+
+    for (auto _ : state) {
+        product.SetLhsRows(indices, rows);
+        benchmark::DoNotOptimize(product.Product());
+    }
+}
+
+void BenchIncrementalRankUpdate(benchmark::State& state) {
+    s_fast::IncrementalProduct<double> product(RandomMatrix(kSize, kSize, 1),
+                                               RandomMatrix(kSize, kSize, 2));
+    s_fast::Matrix<double> u = RandomMatrix(kSize, state.range(0), 3);
+    s_fast::Matrix<double> v = RandomMatrix(state.range(0), kSize, 4);
+
+    for (auto _ : state) {
+        product.UpdateLhs(u, v);
+        benchmark::DoNotOptimize(product.Product());
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchIncrementalRecompute)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(4);
+
+BENCHMARK(BenchIncrementalRows)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(4)
+    ->Arg(64);
+
+BENCHMARK(BenchIncrementalRankUpdate)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(4)
+    ->Arg(16);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "../src/executor.h"
+#include "../src/lu.h"
+#include "bench_constants.h"
+
+namespace {
+
+s_fast::Matrix<double> RandomSquare(size_t size) {
+    using bench_utils::BenchmarkConstants;
+
+    std::uniform_real_distribution<double> distribution(BenchmarkConstants::kMinElementValue,
+                                                        BenchmarkConstants::kMaxElementValue);
+    return s_fast::Random<double>(size, size, distribution, 1);
+}
+
+//  Right-looking LU one column at a time, every update a row operation: the reference the
+//  recursive factorization is measured against.
+void BenchLUUnblocked(benchmark::State& state) {
+    s_fast::Matrix<double> a = RandomSquare(state.range(0));
+
+    for (auto _ : state) {
+        s_fast::Matrix<double> factors = a;
+        std::vector<s_fast::utils::Index> pivots(a.Rows());
+        s_fast::detail_lu::FactorPanel({0, a.Rows()}, &factors, &pivots);
+        benchmark::DoNotOptimize(factors);
+    }
+}
+
+void BenchLU(benchmark::State& state) {
+    s_fast::Matrix<double> a = RandomSquare(state.range(0));
+
+    for (auto _ : state) {
+        s_fast::LUDecomposition<double> lu(a);
+        benchmark::DoNotOptimize(lu);
+    }
+}
+
+void BenchLUParallel(benchmark::State& state) {
+    s_fast::Matrix<double> a = RandomSquare(state.range(0));
+
+    for (auto _ : state) {
+        s_fast::LUDecomposition<double> lu(a, &s_fast::DefaultExecutor());
+        benchmark::DoNotOptimize(lu);
+    }
+}
+
+void BenchInverse(benchmark::State& state) {
+    s_fast::Matrix<double> a = RandomSquare(state.range(0));
+
+    for (auto _ : state) {
+        s_fast::Matrix<double> inverse = s_fast::Inverse(a);
+        benchmark::DoNotOptimize(inverse);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchLUUnblocked)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(512)
+    ->Arg(1024);
+
+BENCHMARK(BenchLU)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(512)
+    ->Arg(1024);
+
+BENCHMARK(BenchLUParallel)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(512)
+    ->Arg(1024);
+
+BENCHMARK(BenchInverse)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(512)
+    ->Arg(1024);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/modular.h"
+#include "../src/strassen.h"
+#include "bench_constants.h"
+
+namespace {
+
+using Element = s_fast::ModInt<998244353>;
+
+s_fast::Matrix<Element> RandomModular(size_t rows, size_t columns) {
+    return s_fast::Random<Element>(
+        rows, columns, std::uniform_int_distribution<int64_t>(0, Element::kModulus - 1));
+}
+
+void BenchModularSimd(benchmark::State& state) {
+    using s_fast::Matrix;
+    using s_fast::SimdMultiplication;
+
+    Matrix<Element> a = RandomModular(state.range(0), state.range(1));
+    Matrix<Element> b = RandomModular(state.range(1), state.range(2));
+
+    for (auto _ : state) {
+        Matrix<Element> result = SimdMultiplication(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BenchModularStrassen(benchmark::State& state) {
+    using s_fast::Matrix;
+    using s_fast::Strassen;
+
+    Matrix<Element> a = RandomModular(state.range(0), state.range(1));
+    Matrix<Element> b = RandomModular(state.range(1), state.range(2));
+
+    for (auto _ : state) {
+        Matrix<Element> result = Strassen(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchModularSimd)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchModularStrassen)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
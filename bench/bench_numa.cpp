@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../src/executor.h"
+#include "../src/simd_multiplication.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  Operands are filled by the calling thread, the result is first touched by the pool's threads.
+template <class Pool>
+void BenchParallelSimd(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimdMultiplication;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> b = Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+
+    Pool pool;
+
+    for (auto _ : state) {
+        Matrix<double> result;
+        SimdMultiplication(a, b, &result, &pool);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchParallelSimd<s_fast::ThreadPool>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->UseRealTime()
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchParallelSimd<s_fast::NumaThreadPool>)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->UseRealTime()
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
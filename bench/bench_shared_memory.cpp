@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <thread>
+
+#include "../src/executor.h"
+#include "../src/shared_memory_multiplication.h"
+#include "../src/simd_multiplication.h"
+#include "bench_constants.h"
+
+namespace {
+
+int Workers() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void BenchSharedMemoryProcesses(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SharedMemoryMultiplication;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> b = Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+
+    for (auto _ : state) {
+        Matrix<double> result = SharedMemoryMultiplication(a, b, Workers());
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+//  Baseline for the processes benchmark: one process using the same number of threads.
+void BenchSharedMemoryThreads(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimdMultiplication;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> b = Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+
+    s_fast::ThreadPool pool(Workers());
+
+    for (auto _ : state) {
+        Matrix<double> result;
+        SimdMultiplication(a, b, &result, &pool);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchSharedMemoryProcesses)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->UseRealTime()
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchSharedMemoryThreads)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->UseRealTime()
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
@@ -2,8 +2,10 @@
 #include <cstddef>
 #include <random>
 
+#include "../src/packed_matrix.h"
 #include "../src/simd_multiplication.h"
 #include "bench_constants.h"
+#include "perf_counters.h"
 
 namespace {
 
@@ -26,6 +28,59 @@ void BenchAvx(benchmark::State& state) {
         std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
                                                BenchmarkConstants::kMaxElementValue));
 
+    bench_utils::PerfCounters counters;
+    counters.Start();
+    for (auto _ : state) {
+        Matrix<double> result = SimdMultiplication(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+    counters.Stop();
+    counters.Report(state, bench_utils::GemmFlops(n, m, k),
+                    bench_utils::GemmBytes<double>(n, m, k));
+}
+
+void BenchAvxGram(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimdMultiplication;
+    using s_fast::TransposedView;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+
+    Matrix<double> x = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+
+    for (auto _ : state) {
+        Matrix<double> result = SimdMultiplication(x, TransposedView(x));
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+//  Same product with rhs packed once outside of the loop, as for a fixed weight matrix.
+void BenchAvxPacked(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::PackedMatrix;
+    using s_fast::Random;
+    using s_fast::SimdMultiplication;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    PackedMatrix<double> b(Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue)));
+
     for (auto _ : state) {
         Matrix<double> result = SimdMultiplication(a, b);
         benchmark::DoNotOptimize(result);
@@ -40,3 +95,16 @@ BENCHMARK(BenchAvx)
     ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
             bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
             bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchAvxGram)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix});
+
+BENCHMARK(BenchAvxPacked)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
@@ -4,6 +4,7 @@
 
 #include "../src/simple_multiplication.h"
 #include "bench_constants.h"
+#include "perf_counters.h"
 
 namespace {
 
@@ -26,10 +27,15 @@ void BenchSimpleMult(benchmark::State& state) {
         std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
                                                BenchmarkConstants::kMaxElementValue));
 
+    bench_utils::PerfCounters counters;
+    counters.Start();
     for (auto _ : state) {
         Matrix<double> result = SimpleMultiplication(a, b);
         benchmark::DoNotOptimize(result);
     }
+    counters.Stop();
+    counters.Report(state, bench_utils::GemmFlops(n, m, k),
+                    bench_utils::GemmBytes<double>(n, m, k));
 }
 
 void BenchSimpleMultWithTranspose(benchmark::State& state) {
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/simd_multiplication.h"
+#include "../src/skinny_multiplication.h"
+#include "../src/strassen.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  Tall-skinny (kLong x kNarrow times kNarrow x kNarrow) and inner-heavy (kNarrow x kLong times
+//  kLong x kNarrow) products.
+constexpr int64_t kLong = 250000;
+constexpr int64_t kNarrow = 32;
+
+template <class Multiply>
+void BenchSkinny(benchmark::State& state, Multiply multiply) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    std::uniform_real_distribution<double> distribution(BenchmarkConstants::kMinElementValue,
+                                                        BenchmarkConstants::kMaxElementValue);
+    Matrix<double> a = Random<double>(n, m, distribution, 1);
+    Matrix<double> b = Random<double>(m, k, distribution, 2);
+
+    for (auto _ : state) {
+        Matrix<double> result = multiply(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+void BenchSkinnySimd(benchmark::State& state) {
+    BenchSkinny(state,
+                [](const auto& a, const auto& b) { return s_fast::SimdMultiplication(a, b); });
+}
+
+void BenchSkinnyStrassen(benchmark::State& state) {
+    BenchSkinny(state, [](const auto& a, const auto& b) { return s_fast::Strassen(a, b); });
+}
+
+void BenchSkinnyCacheOblivious(benchmark::State& state) {
+    BenchSkinny(state,
+                [](const auto& a, const auto& b) { return s_fast::CacheObliviousMult(a, b); });
+}
+
+void BenchSkinnyParallel(benchmark::State& state) {
+    BenchSkinny(state, [](const auto& a, const auto& b) {
+        if (a.Rows() > a.Columns()) {
+            return s_fast::TallSkinnyMultiplication(a, b, &s_fast::DefaultExecutor());
+        }
+        return s_fast::SplitKMultiplication(a, b, &s_fast::DefaultExecutor());
+    });
+}
+
+}  // namespace
+
+BENCHMARK(BenchSkinnySimd)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({kLong, kNarrow, kNarrow})
+    ->Args({kNarrow, kLong, kNarrow});
+
+BENCHMARK(BenchSkinnyStrassen)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({kLong, kNarrow, kNarrow})
+    ->Args({kNarrow, kLong, kNarrow});
+
+BENCHMARK(BenchSkinnyCacheOblivious)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({kLong, kNarrow, kNarrow})
+    ->Args({kNarrow, kLong, kNarrow});
+
+BENCHMARK(BenchSkinnyParallel)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Args({kLong, kNarrow, kNarrow})
+    ->Args({kNarrow, kLong, kNarrow});
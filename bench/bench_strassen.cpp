@@ -4,6 +4,7 @@
 
 #include "../src/strassen.h"
 #include "bench_constants.h"
+#include "perf_counters.h"
 
 namespace {
 
@@ -26,10 +27,45 @@ void BenchStrassen(benchmark::State& state) {
         std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
                                                BenchmarkConstants::kMaxElementValue));
 
+    bench_utils::PerfCounters counters;
+    counters.Start();
     for (auto _ : state) {
         Matrix<double> result = Strassen(a, b);
         benchmark::DoNotOptimize(result);
     }
+    counters.Stop();
+    counters.Report(state, bench_utils::GemmFlops(n, m, k),
+                    bench_utils::GemmBytes<double>(n, m, k));
+}
+
+void BenchStrassenMorton(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::MortonMatrix;
+    using s_fast::Random;
+    using s_fast::Strassen;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> b = Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+
+    auto tiles = s_fast::MortonTilesPerSide(a, b);
+    MortonMatrix<double> a_morton = s_fast::ToMorton(a, tiles);
+    MortonMatrix<double> b_morton = s_fast::ToMorton(b, tiles);
+
+    for (auto _ : state) {
+        MortonMatrix<double> result = Strassen(a_morton, b_morton);
+        benchmark::DoNotOptimize(result);
+    }
 }
 
 }  // namespace
@@ -40,3 +76,10 @@ BENCHMARK(BenchStrassen)
     ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
             bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
             bench_utils::BenchmarkConstants::kColumnsRightMatrix});
+
+BENCHMARK(BenchStrassenMorton)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kSecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
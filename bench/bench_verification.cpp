@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../src/simd_multiplication.h"
+#include "../src/verification.h"
+#include "bench_constants.h"
+
+namespace {
+
+//  Cost of checking a product, to compare with BenchAvx computing it.
+void BenchVerify(benchmark::State& state) {
+    using bench_utils::BenchmarkConstants;
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    size_t n = state.range(0);
+    size_t m = state.range(1);
+    size_t k = state.range(2);
+
+    Matrix<double> a = Random<double>(
+        n, m,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> b = Random<double>(
+        m, k,
+        std::uniform_real_distribution<double>(BenchmarkConstants::kMinElementValue,
+                                               BenchmarkConstants::kMaxElementValue));
+    Matrix<double> c = s_fast::SimdMultiplication(a, b);
+
+    for (auto _ : state) {
+        bool correct = s_fast::Verify(a, b, c);
+        benchmark::DoNotOptimize(correct);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BenchVerify)
+    ->Iterations(bench_utils::BenchmarkConstants::kIterationCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({bench_utils::BenchmarkConstants::kRowsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsLeftMatrix,
+            bench_utils::BenchmarkConstants::kColumnsRightMatrix});
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace bench_utils {
+
+namespace detail_perf {
+
+struct Event {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+    //  Floating point operations per counted event, 0 for events that are not fp ops.
+    int flops;
+};
+
+inline uint64_t CacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+//  FP_ARITH_INST_RETIRED with the given umask. Counts fma twice, so multiplying by the number of
+//  lanes gives floating point operations.
+inline uint64_t IntelFpArith(uint64_t umask) {
+    return 0xc7 | (umask << 8);
+}
+
+inline bool IsIntel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("vendor_id", 0) == 0) {
+            return line.find("GenuineIntel") != std::string::npos;
+        }
+    }
+    return false;
+}
+
+inline std::vector<Event> Events() {
+    std::vector<Event> events = {
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 0},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 0},
+        {"l1d_misses", PERF_TYPE_HW_CACHE,
+         CacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                     PERF_COUNT_HW_CACHE_RESULT_MISS),
+         0},
+        {"llc_misses", PERF_TYPE_HW_CACHE,
+         CacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                     PERF_COUNT_HW_CACHE_RESULT_MISS),
+         0},
+        {"dtlb_misses", PERF_TYPE_HW_CACHE,
+         CacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                     PERF_COUNT_HW_CACHE_RESULT_MISS),
+         0},
+    };
+
+    //  There is no generic fp event, the raw ones are model specific.
+    if (IsIntel()) {
+        events.push_back({"fp_scalar", PERF_TYPE_RAW, IntelFpArith(0x03), 1});
+        events.push_back({"fp_128_double", PERF_TYPE_RAW, IntelFpArith(0x04), 2});
+        events.push_back({"fp_128_single", PERF_TYPE_RAW, IntelFpArith(0x08), 4});
+        events.push_back({"fp_256_double", PERF_TYPE_RAW, IntelFpArith(0x10), 4});
+        events.push_back({"fp_256_single", PERF_TYPE_RAW, IntelFpArith(0x20), 8});
+    }
+
+    return events;
+}
+
+inline int Open(const Event& event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}  // namespace detail_perf
+
+//  Nominal flops and minimal memory traffic of an n x m by m x k product.
+inline double GemmFlops(int64_t n, int64_t m, int64_t k) {
+    return 2. * n * m * k;
+}
+
+template <class T>
+double GemmBytes(int64_t n, int64_t m, int64_t k) {
+    return static_cast<double>(n * m + m * k + n * k) * sizeof(T);
+}
+
+//  Hardware counters of the calling thread and the threads it starts, read with perf_event_open.
+//  Off unless S_FAST_PERF_COUNTERS is set. Events the kernel refuses (containers, virtual
+//  machines, perf_event_paranoid) are skipped one by one, so a benchmark always runs and reports
+//  whatever is available. Usage:
+//
+//      PerfCounters counters;
+//      counters.Start();
+//      for (auto _ : state) { ... }
+//      counters.Stop();
+//      counters.Report(state, flops, bytes);
+class PerfCounters {
+public:
+    PerfCounters() {
+        const char* enabled = std::getenv("S_FAST_PERF_COUNTERS");
+        if (enabled == nullptr || std::strcmp(enabled, "0") == 0) {
+            return;
+        }
+
+        requested_ = true;
+        for (const auto& event : detail_perf::Events()) {
+            int fd = detail_perf::Open(event);
+            if (fd >= 0) {
+                counters_.push_back({event, fd, 0});
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+        for (const auto& counter : counters_) {
+            close(counter.fd);
+        }
+    }
+
+    void Start() {
+        for (const auto& counter : counters_) {
+            ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void Stop() {
+        for (auto& counter : counters_) {
+            ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            //  value, time enabled, time running; scaled up if the event was multiplexed.
+            uint64_t values[3] = {0, 0, 0};
+            if (read(counter.fd, values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+                counter.value = -1;
+                continue;
+            }
+            counter.value = static_cast<double>(values[0]) * values[1] / values[2];
+        }
+    }
+
+    //  Adds the counters per iteration to state, with ipc and the arithmetic intensity: flops
+    //  per byte of llc traffic. flops is the nominal count per iteration, used when the fp events
+    //  are unavailable; with them the measured operations are reported as well. bytes is the
+    //  minimal traffic (operands and result) per iteration, llc_bytes is reported next to it.
+    void Report(benchmark::State& state, double flops, double bytes) const {
+        using benchmark::Counter;
+
+        double iterations = static_cast<double>(state.iterations());
+        if (requested_ && counters_.empty()) {
+            state.SetLabel("perf counters unavailable");
+        }
+        if (counters_.empty() || iterations == 0) {
+            return;
+        }
+
+        double cycles = -1;
+        double instructions = -1;
+        double llc_misses = -1;
+        double fp_ops = 0;
+        bool has_fp_ops = false;
+
+        for (const auto& counter : counters_) {
+            if (counter.value < 0) {
+                continue;
+            }
+            double per_iteration = counter.value / iterations;
+            std::string name = counter.event.name;
+
+            if (counter.event.flops != 0) {
+                fp_ops += per_iteration * counter.event.flops;
+                has_fp_ops = true;
+                continue;
+            }
+            state.counters[name] = Counter(per_iteration);
+
+            if (name == "cycles") {
+                cycles = per_iteration;
+            } else if (name == "instructions") {
+                instructions = per_iteration;
+            } else if (name == "llc_misses") {
+                llc_misses = per_iteration;
+            }
+        }
+
+        state.counters["flops"] = Counter(flops);
+        if (has_fp_ops) {
+            state.counters["fp_ops"] = Counter(fp_ops);
+        }
+        if (cycles > 0 && instructions >= 0) {
+            state.counters["ipc"] = Counter(instructions / cycles);
+        }
+        if (llc_misses > 0) {
+            double llc_bytes = llc_misses * kCacheLine;
+            state.counters["llc_bytes"] = Counter(llc_bytes);
+            state.counters["min_bytes"] = Counter(bytes);
+            state.counters["intensity"] = Counter((has_fp_ops ? fp_ops : flops) / llc_bytes);
+        }
+    }
+
+private:
+    static constexpr double kCacheLine = 64;
+
+    struct OpenEvent {
+        detail_perf::Event event;
+        int fd;
+        double value;
+    };
+
+    bool requested_ = false;
+    std::vector<OpenEvent> counters_;
+};
+
+}  // namespace bench_utils
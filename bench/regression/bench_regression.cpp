@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+
+#include "../../src/cache_oblivious_multpiplication.h"
+#include "../../src/packed_matrix.h"
+#include "../../src/simd_multiplication.h"
+#include "../../src/simple_multiplication.h"
+#include "../../src/strassen.h"
+
+//  Fixed suite for the regression gate. Every case is a (engine, element type, shape) triple with
+//  shapes small enough for the whole suite to finish in a few minutes. Cases must keep their
+//  names: bench/regression/baseline.json is matched by them.
+
+namespace {
+
+constexpr int kRepetitions = 5;
+
+template <class T>
+s_fast::Matrix<T> RandomOperand(int64_t rows, int64_t columns, uint64_t seed) {
+    return s_fast::Random<T>(rows, columns, std::uniform_int_distribution<int>(-100, 100), seed);
+}
+
+template <class T, class Multiply>
+void Run(benchmark::State& state, Multiply multiply) {
+    s_fast::Matrix<T> a = RandomOperand<T>(state.range(0), state.range(1), 1);
+    s_fast::Matrix<T> b = RandomOperand<T>(state.range(1), state.range(2), 2);
+
+    for (auto _ : state) {
+        auto result = multiply(a, b);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["flops"] = benchmark::Counter(
+        2.0 * state.range(0) * state.range(1) * state.range(2) * state.iterations(),
+        benchmark::Counter::kIsRate);
+}
+
+template <class T>
+void Simple(benchmark::State& state) {
+    Run<T>(state, [](const auto& a, const auto& b) { return s_fast::SimpleMultiplication(a, b); });
+}
+
+template <class T>
+void Simd(benchmark::State& state) {
+    Run<T>(state, [](const auto& a, const auto& b) { return s_fast::SimdMultiplication(a, b); });
+}
+
+template <class T>
+void Packed(benchmark::State& state) {
+    s_fast::PackedMatrix<T> b(RandomOperand<T>(state.range(1), state.range(2), 2));
+    Run<T>(state, [&b](const auto& a, const auto&) { return s_fast::SimdMultiplication(a, b); });
+}
+
+template <class T>
+void Strassen(benchmark::State& state) {
+    Run<T>(state, [](const auto& a, const auto& b) { return s_fast::Strassen(a, b); });
+}
+
+template <class T>
+void CacheOblivious(benchmark::State& state) {
+    Run<T>(state, [](const auto& a, const auto& b) { return s_fast::CacheObliviousMult(a, b); });
+}
+
+void Shapes(benchmark::internal::Benchmark* benchmark) {
+    benchmark->Args({128, 128, 128})
+        ->Args({384, 384, 384})
+        ->Args({1024, 64, 256})
+        ->Args({64, 1024, 64})
+        ->Unit(benchmark::kMillisecond)
+        ->Repetitions(kRepetitions)
+        ->ReportAggregatesOnly(true);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(Simple, double)
+    ->Args({128, 128, 128})
+    ->Unit(benchmark::kMillisecond)
+    ->Repetitions(kRepetitions)
+    ->ReportAggregatesOnly(true);
+
+BENCHMARK_TEMPLATE(Simd, float)->Apply(Shapes);
+BENCHMARK_TEMPLATE(Simd, double)->Apply(Shapes);
+BENCHMARK_TEMPLATE(Simd, int)->Apply(Shapes);
+BENCHMARK_TEMPLATE(Packed, float)->Apply(Shapes);
+BENCHMARK_TEMPLATE(Packed, double)->Apply(Shapes);
+BENCHMARK_TEMPLATE(Strassen, double)->Apply(Shapes);
+BENCHMARK_TEMPLATE(Strassen, int)->Apply(Shapes);
+BENCHMARK_TEMPLATE(CacheOblivious, double)->Apply(Shapes);
+BENCHMARK_TEMPLATE(CacheOblivious, int)->Apply(Shapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Compares a Google Benchmark JSON run of bench_regression with the local baseline.
+
+Usage: compare.py BASELINE [CURRENT] [--tolerances FILE]
+
+Every case is matched by name and its median real time is compared. A case is a regression if
+it is slower than the baseline by more than its tolerance, taken from the tolerances file
+(first matching regular expression, otherwise the default). Cases missing from the current run
+also fail the check. Exits with 1 if any case failed.
+
+The baseline is specific to the machine and build, so it is not committed: it is recorded locally
+with `make bench_regression_update` from a Release build. Without CURRENT only checks that the
+baseline exists, so the check fails before running the benchmarks.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load_times(path):
+    """Median real time in seconds for every case, keyed by name without the aggregate suffix."""
+    with open(path) as file:
+        report = json.load(file)
+
+    times = {}
+    for entry in report["benchmarks"]:
+        if entry.get("run_type") == "aggregate" and entry.get("aggregate_name") != "median":
+            continue
+        name = entry.get("run_name", entry["name"])
+        seconds = entry["real_time"] * TIME_UNITS[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate" or name not in times:
+            times[name] = seconds
+    return times
+
+
+def load_tolerances(path):
+    with open(path) as file:
+        config = json.load(file)
+    overrides = [(re.compile(pattern), value) for pattern, value in config.get("cases", {}).items()]
+    return config["default"], overrides
+
+
+def tolerance_for(name, default, overrides):
+    for pattern, value in overrides:
+        if pattern.search(name):
+            return value
+    return default
+
+
+def check_baseline(path):
+    if os.path.exists(path):
+        return True
+    print(f"No benchmark baseline at {path}.\n"
+          "Baselines depend on the machine and the build and are not committed. Record one on\n"
+          "this machine from a Release build first:\n\n"
+          "    cmake -DCMAKE_BUILD_TYPE=RELEASE ..\n"
+          "    make bench_regression_update\n", file=sys.stderr)
+    return False
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current", nargs="?")
+    parser.add_argument("--tolerances", default=None)
+    args = parser.parse_args()
+
+    if not check_baseline(args.baseline):
+        return 1
+    if args.current is None:
+        return 0
+
+    baseline = load_times(args.baseline)
+    current = load_times(args.current)
+    default, overrides = load_tolerances(args.tolerances) if args.tolerances else (0.1, [])
+
+    rows = []
+    failed = 0
+    for name in sorted(baseline):
+        tolerance = tolerance_for(name, default, overrides)
+        if name not in current:
+            rows.append((name, baseline[name], None, None, tolerance, "MISSING"))
+            failed += 1
+            continue
+
+        change = current[name] / baseline[name] - 1
+        status = "ok"
+        if change > tolerance:
+            status = "REGRESSION"
+            failed += 1
+        elif change < -tolerance:
+            status = "faster"
+        rows.append((name, baseline[name], current[name], change, tolerance, status))
+
+    for name in sorted(set(current) - set(baseline)):
+        rows.append((name, None, current[name], None, None, "new"))
+
+    width = max([len(row[0]) for row in rows] + [4])
+    print(f"{'case':<{width}}  {'baseline':>10}  {'current':>10}  {'change':>8}  "
+          f"{'limit':>6}  status")
+    for name, old, new, change, tolerance, status in rows:
+        old_text = f"{old * 1e3:.3f}ms" if old is not None else "-"
+        new_text = f"{new * 1e3:.3f}ms" if new is not None else "-"
+        change_text = f"{change:+.1%}" if change is not None else "-"
+        limit_text = f"{tolerance:.0%}" if tolerance is not None else "-"
+        print(f"{name:<{width}}  {old_text:>10}  {new_text:>10}  {change_text:>8}  "
+              f"{limit_text:>6}  {status}")
+
+    print(f"\n{len(baseline)} baseline cases, {failed} failed")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -4,4 +4,22 @@ add_executable(
   bench/bench_simd.cpp
   bench/bench_strassen.cpp
   bench/bench_cache_oblivious_mult.cpp
+  bench/bench_modular.cpp
+  bench/bench_symmetric.cpp
+  bench/bench_shared_memory.cpp
+  bench/bench_numa.cpp
+  bench/bench_huge_pages.cpp
+  bench/bench_complex.cpp
+  bench/bench_verification.cpp
+  bench/bench_convolution.cpp
+  bench/bench_skinny.cpp
+  bench/bench_lu.cpp
+  bench/bench_epilogue.cpp
+  bench/bench_block_sparse.cpp
+  bench/bench_incremental_product.cpp
+)
+
+add_executable(
+  bench_regression
+  bench/regression/bench_regression.cpp
 )
@@ -3,3 +3,21 @@
 #include "../../src/simd_multiplication.h"
 #include "../../src/simple_multiplication.h"
 #include "../../src/cache_oblivious_multpiplication.h"
+#include "../../src/async_multiplication.h"
+#include "../../src/chain_multiplication.h"
+#include "../../src/modular.h"
+#include "../../src/morton_matrix.h"
+#include "../../src/power.h"
+#include "../../src/symmetric_multiplication.h"
+#include "../../src/shared_memory_multiplication.h"
+#include "../../src/allocator.h"
+#include "../../src/packed_matrix.h"
+#include "../../src/stream_multiplication.h"
+#include "../../src/complex_multiplication.h"
+#include "../../src/verification.h"
+#include "../../src/convolution.h"
+#include "../../src/skinny_multiplication.h"
+#include "../../src/lu.h"
+#include "../../src/epilogue.h"
+#include "../../src/block_sparse_matrix.h"
+#include "../../src/incremental_product.h"
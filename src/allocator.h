@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace s_fast {
+
+namespace detail_allocator {
+
+constexpr size_t kHugePageSize = size_t{2} << 20;
+
+//  Blocks of at least this many bytes are aligned to huge pages.
+constexpr size_t kHugePageThreshold = 2 * kHugePageSize;
+
+inline std::atomic<bool>& HugePagesFlag() {
+    static std::atomic<bool> enabled = true;
+    return enabled;
+}
+
+inline void* Allocate(size_t bytes) {
+    if (bytes < kHugePageThreshold) {
+        return ::operator new(bytes);
+    }
+
+    size_t rounded = (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    void* pointer = std::aligned_alloc(kHugePageSize, rounded);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+
+#ifdef MADV_HUGEPAGE
+    //  Only advice: without transparent huge pages in the kernel the block keeps 4 KiB pages.
+    madvise(pointer, rounded, HugePagesFlag() ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+#endif
+
+    return pointer;
+}
+
+inline void Deallocate(void* pointer, size_t bytes) {
+    if (bytes < kHugePageThreshold) {
+        ::operator delete(pointer);
+    } else {
+        std::free(pointer);
+    }
+}
+
+}  // namespace detail_allocator
+
+//  Whether Matrix storage of at least a few MiB asks the kernel for 2 MiB transparent huge pages.
+//  Enabled by default; affects only allocations made after the call.
+inline void SetHugePages(bool enabled) {
+    detail_allocator::HugePagesFlag() = enabled;
+}
+
+inline bool HugePagesEnabled() {
+    return detail_allocator::HugePagesFlag();
+}
+
+//  Allocator of Matrix storage. Large blocks are aligned to huge pages, so the TLB covers them with
+//  512 times fewer entries. construct() without arguments default-initializes, so resize() of a
+//  vector of numbers leaves the new elements unwritten and their pages untouched.
+template <class T>
+struct MatrixAllocator {
+    using value_type = T;
+
+    MatrixAllocator() = default;
+
+    template <class U>
+    MatrixAllocator(const MatrixAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t size) {
+        return static_cast<T*>(detail_allocator::Allocate(size * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t size) noexcept {
+        detail_allocator::Deallocate(pointer, size * sizeof(T));
+    }
+
+    template <class U>
+    void construct(U* pointer) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template <class U, class... Args>
+    void construct(U* pointer, Args&&... args) {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+};
+
+template <class T, class U>
+bool operator==(const MatrixAllocator<T>&, const MatrixAllocator<U>&) {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const MatrixAllocator<T>&, const MatrixAllocator<U>&) {
+    return false;
+}
+
+}  // namespace s_fast
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "simd_multiplication.h"
+#include "utils.h"
+
+namespace s_fast {
+
+namespace detail_async {
+
+template <class T>
+struct Pipeline {
+    using Index = typename Matrix<T>::Index;
+
+    std::vector<const Matrix<T>*> operands;
+    std::vector<Matrix<T>> transposed;
+    std::vector<Matrix<T>> stages;
+
+    std::promise<Matrix<T>> promise;
+    std::atomic<Index> blocks_left = 0;
+    std::atomic<bool> failed = false;
+
+    void Fail(std::exception_ptr error) {
+        if (!failed.exchange(true)) {
+            promise.set_exception(error);
+        }
+    }
+};
+
+//  Pushes one row block of the leftmost operand through every stage of the chain. Row block
+//  of (A * B) * C depends only on the same row block of A * B, so blocks never wait on each other.
+template <class T>
+void RunBlock(Pipeline<T>* pipeline, typename Matrix<T>::Index row_begin,
+              typename Matrix<T>::Index row_end) {
+    const Matrix<T>* input = pipeline->operands.front();
+
+    for (size_t stage = 0; stage < pipeline->stages.size(); ++stage) {
+        detail_simd::MultiplyRows(*input, pipeline->transposed[stage], row_begin, row_end,
+                                  &pipeline->stages[stage]);
+        input = &pipeline->stages[stage];
+    }
+}
+
+template <class T>
+void Prepare(Pipeline<T>* pipeline) {
+    const auto& operands = pipeline->operands;
+
+    for (size_t i = 1; i < operands.size(); ++i) {
+        assert(operands[i - 1]->Columns() == operands[i]->Rows());
+
+        pipeline->transposed.push_back(Transpose(*operands[i]));
+        pipeline->stages.emplace_back(operands.front()->Rows(), operands[i]->Columns(),
+                                      kUninitialized);
+    }
+}
+
+template <class T>
+void Launch(std::shared_ptr<Pipeline<T>> pipeline, Executor& executor) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
+    executor.Submit([pipeline, &executor] {
+        try {
+            Prepare(pipeline.get());
+        } catch (...) {
+            pipeline->Fail(std::current_exception());
+            return;
+        }
+
+        Index rows = pipeline->operands.front()->Rows();
+        Index blocks = (rows + kAsyncRowBlockSize - 1) / kAsyncRowBlockSize;
+
+        if (blocks == 0) {
+            pipeline->promise.set_value(std::move(pipeline->stages.back()));
+            return;
+        }
+
+        pipeline->blocks_left = blocks;
+
+        for (Index row_begin = 0; row_begin < rows; row_begin += kAsyncRowBlockSize) {
+            Index row_end = std::min(rows, row_begin + kAsyncRowBlockSize);
+
+            Executor::Task block = [pipeline, row_begin, row_end] {
+                if (!pipeline->failed) {
+                    try {
+                        RunBlock(pipeline.get(), row_begin, row_end);
+                    } catch (...) {
+                        pipeline->Fail(std::current_exception());
+                    }
+                }
+
+                if (pipeline->blocks_left.fetch_sub(1) == 1 && !pipeline->failed) {
+                    pipeline->promise.set_value(std::move(pipeline->stages.back()));
+                }
+            };
+            executor.SubmitPart(std::move(block), row_begin / kAsyncRowBlockSize, blocks);
+        }
+    });
+}
+
+}  // namespace detail_async
+
+//  Multiplies lhs * rhs * rest... on the executor. Operands are not copied and must outlive the
+//  returned future. Longer chains are pipelined by row blocks of lhs.
+template <class T, class... Matrices>
+std::future<Matrix<T>> MultiplyAsync(Executor& executor, const Matrix<T>& lhs,
+                                     const Matrix<T>& rhs, const Matrices&... rest) {
+    static_assert((std::is_same_v<Matrices, Matrix<T>> && ...),
+                  "All operands must have the same element type");
+
+    auto pipeline = std::make_shared<detail_async::Pipeline<T>>();
+    pipeline->operands = {&lhs, &rhs, &rest...};
+
+    std::future<Matrix<T>> result = pipeline->promise.get_future();
+    detail_async::Launch(std::move(pipeline), executor);
+
+    return result;
+}
+
+template <class T, class... Matrices>
+std::future<Matrix<T>> MultiplyAsync(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                                     const Matrices&... rest) {
+    return MultiplyAsync(DefaultExecutor(), lhs, rhs, rest...);
+}
+
+}  // namespace s_fast
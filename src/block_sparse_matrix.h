@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "cache_oblivious_multpiplication.h"
+#include "matrix.h"
+#include "morton_matrix.h"
+#include "strassen.h"
+#include "utils.h"
+
+namespace s_fast {
+
+//  Morton matrix with a bitmap of the tiles that may hold non-zeros, for matrices made of large
+//  zero blocks. Tiles are kTileSize x kTileSize and numbered in Z order, so the tiles of every
+//  quadrant on every recursion level are one contiguous range of bits. Writing an element
+//  through operator() marks its tile occupied, even if the value is zero.
+template <class T>
+class BlockSparseMatrix {
+public:
+    using Index = typename Matrix<T>::Index;
+
+    static constexpr Index kTileSize = detail_morton::kTileSize;
+
+    BlockSparseMatrix() = default;
+
+    BlockSparseMatrix(Index rows, Index columns, Index tiles_per_side = 0)
+        : data_(rows, columns, tiles_per_side), occupied_(Words(Tiles()), 0) {
+    }
+
+    //  Tiles that are all zero are left unoccupied.
+    explicit BlockSparseMatrix(const Matrix<T>& matrix, Index tiles_per_side = 0)
+        : data_(matrix, tiles_per_side), occupied_(Words(Tiles()), 0) {
+        using detail_morton::kTileElements;
+
+        for (Index tile = 0; tile < Tiles(); ++tile) {
+            const T* begin = data_.Data() + tile * kTileElements;
+            if (std::any_of(begin, begin + kTileElements, [](const T& x) { return x != T(0); })) {
+                SetOccupied(tile, 1);
+            }
+        }
+    }
+
+    Index Rows() const {
+        return data_.Rows();
+    }
+
+    Index Columns() const {
+        return data_.Columns();
+    }
+
+    Index TilesPerSide() const {
+        return data_.TilesPerSide();
+    }
+
+    Index Tiles() const {
+        return TilesPerSide() * TilesPerSide();
+    }
+
+    bool TileOccupied(Index tile_row, Index tile_column) const {
+        return CountOccupied(TileIndex(tile_row, tile_column), 1) == 1;
+    }
+
+    Index OccupiedTiles() const {
+        return CountOccupied(0, Tiles());
+    }
+
+    T& operator()(Index row, Index column) {
+        SetOccupied(TileIndex(row / kTileSize, column / kTileSize), 1);
+        return data_(row, column);
+    }
+
+    helper::ReturnAs<T> operator()(Index row, Index column) const {
+        return data_(row, column);
+    }
+
+    //  Occupied tiles among Z order tiles [first, first + count). Ranges of quadrants are aligned
+    //  to their power of two length, so a range either fits in one word or covers whole words.
+    Index CountOccupied(Index first, Index count) const {
+        if (count < kWordBits) {
+            uint64_t mask = (uint64_t{1} << count) - 1;
+            return __builtin_popcountll((occupied_[first / kWordBits] >> first % kWordBits) & mask);
+        }
+
+        assert(first % kWordBits == 0 && count % kWordBits == 0);
+
+        Index occupied = 0;
+        for (Index word = first / kWordBits; word < (first + count) / kWordBits; ++word) {
+            occupied += __builtin_popcountll(occupied_[word]);
+        }
+        return occupied;
+    }
+
+    void SetOccupied(Index first, Index count) {
+        for (Index tile = first; tile < first + count; ++tile) {
+            occupied_[tile / kWordBits] |= uint64_t{1} << tile % kWordBits;
+        }
+    }
+
+    const MortonMatrix<T>& Morton() const {
+        return data_;
+    }
+
+    T* Data() {
+        return data_.Data();
+    }
+
+    const T* Data() const {
+        return data_.Data();
+    }
+
+private:
+    static constexpr Index kWordBits = 64;
+
+    static Index Words(Index tiles) {
+        return (tiles + kWordBits - 1) / kWordBits;
+    }
+
+    static Index TileIndex(Index tile_row, Index tile_column) {
+        return detail_morton::TileOffset(tile_row, tile_column) / detail_morton::kTileElements;
+    }
+
+    MortonMatrix<T> data_;
+    std::vector<uint64_t> occupied_;
+};
+
+template <class T>
+Matrix<T> ToRowMajor(const BlockSparseMatrix<T>& matrix) {
+    return ToRowMajor(matrix.Morton());
+}
+
+namespace detail_block_sparse {
+
+using Index = utils::Index;
+
+enum class DenseEngine { kCacheOblivious, kStrassen };
+
+//  result += lhs * rhs for the blocks of tiles x tiles tiles that start at the given Z order
+//  tiles. A pair with an empty operand is skipped whole; a pair of fully occupied blocks goes to
+//  the dense Morton engine; anything else is split into the eight quadrant products. The work is
+//  thus proportional to the number of occupied tile pairs.
+template <class T>
+void Multiply(const BlockSparseMatrix<T>& lhs, const BlockSparseMatrix<T>& rhs, Index lhs_first,
+              Index rhs_first, Index result_first, Index tiles, DenseEngine engine,
+              BlockSparseMatrix<T>* result) {
+    using detail_morton::kTileElements;
+
+    Index count = tiles * tiles;
+    Index lhs_occupied = lhs.CountOccupied(lhs_first, count);
+    Index rhs_occupied = rhs.CountOccupied(rhs_first, count);
+
+    if (lhs_occupied == 0 || rhs_occupied == 0) {
+        return;
+    }
+
+    if (lhs_occupied == count && rhs_occupied == count) {
+        const T* a = lhs.Data() + lhs_first * kTileElements;
+        const T* b = rhs.Data() + rhs_first * kTileElements;
+        T* c = result->Data() + result_first * kTileElements;
+
+        if (engine == DenseEngine::kStrassen) {
+            detail_strassen::Strassen(a, b, c, tiles);
+        } else {
+            detail_cache_oblivious::CacheObliviousMult(a, b, c, tiles);
+        }
+        result->SetOccupied(result_first, count);
+        return;
+    }
+
+    //  A single tile is either empty or full, so tiles > 1 here.
+    Index half = tiles / 2;
+    Index quadrant = half * half;
+
+    for (Index row = 0; row < 2; ++row) {
+        for (Index column = 0; column < 2; ++column) {
+            for (Index k = 0; k < 2; ++k) {
+                Multiply(lhs, rhs, lhs_first + (2 * row + k) * quadrant,
+                         rhs_first + (2 * k + column) * quadrant,
+                         result_first + (2 * row + column) * quadrant, half, engine, result);
+            }
+        }
+    }
+}
+
+template <class T>
+BlockSparseMatrix<T> Multiply(const BlockSparseMatrix<T>& lhs, const BlockSparseMatrix<T>& rhs,
+                              DenseEngine engine) {
+    assert(lhs.Columns() == rhs.Rows() && lhs.TilesPerSide() == rhs.TilesPerSide());
+
+    BlockSparseMatrix<T> result(lhs.Rows(), rhs.Columns(), lhs.TilesPerSide());
+    Multiply(lhs, rhs, 0, 0, 0, lhs.TilesPerSide(), engine, &result);
+
+    return result;
+}
+
+}  // namespace detail_block_sparse
+
+//  Block-sparse products: quadrant pairs with an empty operand are skipped on every level, fully
+//  occupied ones are multiplied by the dense Morton Strassen. The result marks exactly the tiles
+//  some product was added to.
+template <class T>
+BlockSparseMatrix<T> Strassen(const BlockSparseMatrix<T>& lhs, const BlockSparseMatrix<T>& rhs) {
+    return detail_block_sparse::Multiply(lhs, rhs, detail_block_sparse::DenseEngine::kStrassen);
+}
+
+template <class T>
+BlockSparseMatrix<T> CacheObliviousMult(const BlockSparseMatrix<T>& lhs,
+                                        const BlockSparseMatrix<T>& rhs) {
+    return detail_block_sparse::Multiply(lhs, rhs,
+                                         detail_block_sparse::DenseEngine::kCacheOblivious);
+}
+
+}  // namespace s_fast
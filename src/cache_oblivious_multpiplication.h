@@ -1,8 +1,11 @@
 #pragma once
 
+#include "executor.h"
 #include "matrix.h"
+#include "morton_matrix.h"
 #include "view_matrix.h"
 #include "simd_multiplication.h"
+#include "skinny_multiplication.h"
 #include "utils.h"
 
 namespace s_fast {
@@ -15,6 +18,13 @@ void CacheObliviousMult(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>&
     using utils::GetSubMatrixesCacheOblivious;
     using utils::kStopCacheObliviousConstant;
 
+    if constexpr (detail_skinny::kSupported<T>) {
+        if (detail_skinny::IsSkinny(lhs, rhs)) {
+            result += detail_skinny::Multiply(lhs, rhs);
+            return;
+        }
+    }
+
     if (std::min({lhs.Rows(), lhs.Columns(), rhs.Columns()}) <= kStopCacheObliviousConstant) {
         result += SimdMultiplication(GetMatrix(lhs), GetMatrix(rhs));
         return;
@@ -37,17 +47,69 @@ void CacheObliviousMult(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>&
     CacheObliviousMult(lhs_sub.right_bottom, rhs_sub.right_bottom, result_sub.right_bottom);
 }
 
+//  result += lhs * rhs for Morton blocks of tiles x tiles tiles. Quadrants are contiguous, so
+//  every level just offsets the pointers and the leaves multiply unit stride tiles.
+template <class T>
+void CacheObliviousMult(const T* lhs, const T* rhs, T* result, utils::Index tiles) {
+    using detail_morton::kTileElements;
+
+    if (tiles == 1) {
+        detail_morton::MultiplyTile(lhs, rhs, result);
+        return;
+    }
+
+    utils::Index quadrant = (tiles / 2) * (tiles / 2) * kTileElements;
+    utils::Index half = tiles / 2;
+
+    const T* lhs_sub[4] = {lhs, lhs + quadrant, lhs + 2 * quadrant, lhs + 3 * quadrant};
+    const T* rhs_sub[4] = {rhs, rhs + quadrant, rhs + 2 * quadrant, rhs + 3 * quadrant};
+    T* result_sub[4] = {result, result + quadrant, result + 2 * quadrant, result + 3 * quadrant};
+
+    CacheObliviousMult(lhs_sub[0], rhs_sub[0], result_sub[0], half);
+    CacheObliviousMult(lhs_sub[1], rhs_sub[2], result_sub[0], half);
+
+    CacheObliviousMult(lhs_sub[0], rhs_sub[1], result_sub[1], half);
+    CacheObliviousMult(lhs_sub[1], rhs_sub[3], result_sub[1], half);
+
+    CacheObliviousMult(lhs_sub[2], rhs_sub[0], result_sub[2], half);
+    CacheObliviousMult(lhs_sub[3], rhs_sub[2], result_sub[2], half);
+
+    CacheObliviousMult(lhs_sub[2], rhs_sub[1], result_sub[3], half);
+    CacheObliviousMult(lhs_sub[3], rhs_sub[3], result_sub[3], half);
+}
+
 }  // namespace detail_cache_oblivious
 
+//  With an executor lhs and the result are cut into one row block per thread, each multiplied
+//  recursively against the whole rhs.
 template <class T>
-Matrix<T> CacheObliviousMult(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+Matrix<T> CacheObliviousMult(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                             Executor* executor = nullptr) {
     using Index = typename Matrix<T>::Index;
     using detail_cache_oblivious::CacheObliviousMult;
 
     Matrix<T> result(lhs.Rows(), rhs.Columns());
-    ViewMatrix<T> result_view(result);
 
-    CacheObliviousMult(ConstViewMatrix<T>(lhs), ConstViewMatrix<T>(rhs), result_view);
+    Index threads = executor == nullptr ? 1 : static_cast<Index>(executor->Concurrency());
+    Index grain = std::max<Index>(1, (lhs.Rows() + threads - 1) / threads);
+
+    ParallelFor(executor, lhs.Rows(), grain, [&](Index begin, Index end) {
+        ConstViewMatrix<T> lhs_rows(lhs, {begin, 0}, {end, lhs.Columns()});
+        ViewMatrix<T> result_rows(result, {begin, 0}, {end, result.Columns()});
+        CacheObliviousMult(lhs_rows, ConstViewMatrix<T>(rhs), result_rows);
+    });
+
+    return result;
+}
+
+template <class T>
+MortonMatrix<T> CacheObliviousMult(const MortonMatrix<T>& lhs, const MortonMatrix<T>& rhs) {
+    assert(lhs.Columns() == rhs.Rows() && lhs.TilesPerSide() == rhs.TilesPerSide());
+
+    MortonMatrix<T> result(lhs.Rows(), rhs.Columns(), lhs.TilesPerSide());
+
+    detail_cache_oblivious::CacheObliviousMult(lhs.Data(), rhs.Data(), result.Data(),
+                                               lhs.TilesPerSide());
 
     return result;
 }
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "simd_multiplication.h"
+#include "strassen.h"
+#include "utils.h"
+
+namespace s_fast {
+
+template <class T>
+using MatrixChain = std::vector<std::reference_wrapper<const Matrix<T>>>;
+
+enum class ChainEngine { kSimd, kStrassen };
+
+//  One product of the plan. Operand ids below the chain length refer to the input matrices,
+//  id chain length + i refers to the result of steps[i].
+struct ChainStep {
+    using Index = utils::Index;
+
+    Index lhs;
+    Index rhs;
+    Index rows;
+    Index inner;
+    Index columns;
+    ChainEngine engine;
+};
+
+struct ChainPlan {
+    using Index = utils::Index;
+
+    Index chain_length = 0;
+    uint64_t cost = 0;
+    std::vector<ChainStep> steps;
+
+    std::string ToString() const {
+        if (steps.empty()) {
+            return chain_length == 0 ? "" : "M0";
+        }
+
+        return ToString(chain_length + steps.size() - 1);
+    }
+
+private:
+    std::string ToString(Index id) const {
+        if (id < chain_length) {
+            return "M" + std::to_string(id);
+        }
+
+        const ChainStep& step = steps[id - chain_length];
+        return "(" + ToString(step.lhs) + " " + ToString(step.rhs) + ")";
+    }
+};
+
+namespace detail_chain {
+
+using Index = utils::Index;
+
+inline ChainEngine PickEngine(Index rows, Index inner, Index columns) {
+    using utils::kChainStrassenConstant;
+
+    Index smallest = std::min({rows, inner, columns});
+    Index largest = std::max({rows, inner, columns});
+
+    return smallest >= kChainStrassenConstant && largest <= 2 * smallest ? ChainEngine::kStrassen
+                                                                         : ChainEngine::kSimd;
+}
+
+inline Index AppendSteps(const std::vector<std::vector<Index>>& split,
+                         const std::vector<Index>& dimensions, Index first, Index last,
+                         ChainPlan* plan) {
+    if (first == last) {
+        return first;
+    }
+
+    Index middle = split[first][last];
+    Index lhs = AppendSteps(split, dimensions, first, middle, plan);
+    Index rhs = AppendSteps(split, dimensions, middle + 1, last, plan);
+
+    Index rows = dimensions[first];
+    Index inner = dimensions[middle + 1];
+    Index columns = dimensions[last + 1];
+
+    plan->steps.push_back({.lhs = lhs,
+                           .rhs = rhs,
+                           .rows = rows,
+                           .inner = inner,
+                           .columns = columns,
+                           .engine = PickEngine(rows, inner, columns)});
+
+    return plan->chain_length + plan->steps.size() - 1;
+}
+
+template <class T>
+void MultiplySimd(const Matrix<T>& lhs, const Matrix<T>& rhs, Matrix<T>* rhs_t,
+                  Matrix<T>* result, Executor* executor) {
+    rhs_t->Reset(rhs.Columns(), rhs.Rows(), kUninitialized);
+    Transpose(rhs, rhs_t);
+
+    result->Reset(lhs.Rows(), rhs.Columns(), kUninitialized);
+    ParallelFor(executor, lhs.Rows(), utils::kAsyncRowBlockSize,
+                [&](Index row_begin, Index row_end) {
+                    detail_simd::MultiplyRows(lhs, *rhs_t, row_begin, row_end, result);
+                });
+}
+
+}  // namespace detail_chain
+
+//  Classic O(n^3) dynamic programming over the dimensions: matrix i has size
+//  dimensions[i] x dimensions[i + 1].
+inline ChainPlan PlanChain(const std::vector<utils::Index>& dimensions) {
+    using Index = utils::Index;
+
+    assert(!dimensions.empty());
+
+    Index n = dimensions.size() - 1;
+    std::vector<std::vector<uint64_t>> cost(n, std::vector<uint64_t>(n, 0));
+    std::vector<std::vector<Index>> split(n, std::vector<Index>(n, 0));
+
+    for (Index length = 2; length <= n; ++length) {
+        for (Index first = 0; first + length - 1 < n; ++first) {
+            Index last = first + length - 1;
+            cost[first][last] = std::numeric_limits<uint64_t>::max();
+
+            for (Index middle = first; middle < last; ++middle) {
+                uint64_t candidate = cost[first][middle] + cost[middle + 1][last] +
+                                     static_cast<uint64_t>(dimensions[first]) *
+                                         dimensions[middle + 1] * dimensions[last + 1];
+
+                if (candidate < cost[first][last]) {
+                    cost[first][last] = candidate;
+                    split[first][last] = middle;
+                }
+            }
+        }
+    }
+
+    ChainPlan plan;
+    plan.chain_length = n;
+
+    if (n > 0) {
+        plan.cost = cost[0][n - 1];
+        detail_chain::AppendSteps(split, dimensions, 0, n - 1, &plan);
+    }
+
+    return plan;
+}
+
+template <class T>
+ChainPlan PlanChain(const MatrixChain<T>& chain) {
+    std::vector<utils::Index> dimensions;
+
+    for (const Matrix<T>& matrix : chain) {
+        assert(dimensions.empty() || dimensions.back() == matrix.Rows());
+
+        if (dimensions.empty()) {
+            dimensions.push_back(matrix.Rows());
+        }
+        dimensions.push_back(matrix.Columns());
+    }
+
+    return PlanChain(dimensions.empty() ? std::vector<utils::Index>{0} : dimensions);
+}
+
+//  Executes the plan. Intermediate results are released as soon as they are consumed, and their
+//  storage is reused by the following simd products. Every step runs on the executor if one is
+//  given.
+template <class T>
+Matrix<T> MultiplyChain(const MatrixChain<T>& chain, const ChainPlan& plan,
+                        Executor* executor = nullptr) {
+    using Index = utils::Index;
+
+    assert(!chain.empty() && plan.chain_length == static_cast<Index>(chain.size()));
+
+    if (plan.steps.empty()) {
+        return chain.front();
+    }
+
+    std::vector<Matrix<T>> results(plan.steps.size());
+    std::vector<Matrix<T>> free_buffers;
+    Matrix<T> rhs_t;
+
+    auto operand = [&](Index id) -> const Matrix<T>& {
+        return id < plan.chain_length ? chain[id].get() : results[id - plan.chain_length];
+    };
+    auto release = [&](Index id) {
+        if (id >= plan.chain_length) {
+            free_buffers.push_back(std::move(results[id - plan.chain_length]));
+        }
+    };
+
+    for (size_t i = 0; i < plan.steps.size(); ++i) {
+        const ChainStep& step = plan.steps[i];
+
+        if (step.engine == ChainEngine::kStrassen) {
+            results[i] = Strassen(operand(step.lhs), operand(step.rhs), executor);
+        } else {
+            if (!free_buffers.empty()) {
+                results[i] = std::move(free_buffers.back());
+                free_buffers.pop_back();
+            }
+            detail_chain::MultiplySimd(operand(step.lhs), operand(step.rhs), &rhs_t, &results[i],
+                                       executor);
+        }
+
+        release(step.lhs);
+        release(step.rhs);
+    }
+
+    return std::move(results.back());
+}
+
+template <class T>
+Matrix<T> MultiplyChain(const MatrixChain<T>& chain, Executor* executor = nullptr) {
+    return MultiplyChain(chain, PlanChain(chain), executor);
+}
+
+template <class T, class... Matrices>
+Matrix<T> MultiplyChain(const Matrix<T>& first, const Matrices&... rest) {
+    static_assert((std::is_same_v<Matrices, Matrix<T>> && ...),
+                  "All operands must have the same element type");
+
+    return MultiplyChain(MatrixChain<T>{std::cref(first), std::cref(rest)...});
+}
+
+}  // namespace s_fast
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "utils.h"
+
+namespace s_fast {
+
+//  Batch of multichannel images in NCHW order: image, channel, row, column. Stored as a
+//  (batch * channels * height) x width matrix, so every image row is contiguous.
+template <class T>
+class Tensor {
+public:
+    using Index = typename Matrix<T>::Index;
+
+    Tensor() = default;
+
+    Tensor(Index batch, Index channels, Index height, Index width)
+        : batch_(batch),
+          channels_(channels),
+          height_(height),
+          data_(batch * channels * height, width) {
+    }
+
+    Tensor(Index batch, Index channels, Index height, Index width, Uninitialized)
+        : batch_(batch),
+          channels_(channels),
+          height_(height),
+          data_(batch * channels * height, width, kUninitialized) {
+    }
+
+    Index Batch() const {
+        return batch_;
+    }
+
+    Index Channels() const {
+        return channels_;
+    }
+
+    Index Height() const {
+        return height_;
+    }
+
+    Index Width() const {
+        return data_.Columns();
+    }
+
+    T& operator()(Index image, Index channel, Index row, Index column) {
+        return data_((image * channels_ + channel) * height_ + row, column);
+    }
+
+    const T& operator()(Index image, Index channel, Index row, Index column) const {
+        return data_.Data()[((image * channels_ + channel) * height_ + row) * Width() + column];
+    }
+
+    //  Plane of one channel of one image, height x width row major.
+    T* Plane(Index image, Index channel) {
+        return data_.Data() + (image * channels_ + channel) * height_ * Width();
+    }
+
+    const T* Plane(Index image, Index channel) const {
+        return data_.Data() + (image * channels_ + channel) * height_ * Width();
+    }
+
+    inline friend bool operator==(const Tensor<T>& lhs, const Tensor<T>& rhs) {
+        return lhs.batch_ == rhs.batch_ && lhs.channels_ == rhs.channels_ &&
+               lhs.height_ == rhs.height_ && lhs.data_ == rhs.data_;
+    }
+
+private:
+    Index batch_ = 0;
+    Index channels_ = 0;
+    Index height_ = 0;
+    Matrix<T> data_;
+};
+
+struct Conv2DParams {
+    utils::Index stride_rows = 1;
+    utils::Index stride_columns = 1;
+    utils::Index padding_rows = 0;
+    utils::Index padding_columns = 0;
+};
+
+namespace detail_convolution {
+
+using Index = utils::Index;
+
+//  Output pixels per tile, in packed panels. A tile of the unrolled input is
+//  (channels * kernel area) x kTilePanels * kPanelWidth and is reused by every filter.
+constexpr Index kTilePanels = 4;
+
+struct Shape {
+    Index channels;
+    Index height;
+    Index width;
+    Index kernel_rows;
+    Index kernel_columns;
+    Index output_height;
+    Index output_width;
+    Conv2DParams params;
+
+    Index Inner() const {
+        return channels * kernel_rows * kernel_columns;
+    }
+
+    Index Pixels() const {
+        return output_height * output_width;
+    }
+};
+
+//  im2col of output pixels [first, first + width) of one image, written as one packed panel:
+//  inner x kPanelWidth row major, row (channel, ky, kx), zero for padding and missing pixels.
+template <class T>
+void PackPanel(const T* image, const Shape& shape, Index first, Index width, T* panel) {
+    constexpr Index kPanelWidth = detail_packed::kPanelWidth<T>;
+
+    Index source_rows[kPanelWidth];
+    Index source_columns[kPanelWidth];
+    for (Index j = 0; j < width; ++j) {
+        Index pixel = first + j;
+        source_rows[j] = pixel / shape.output_width * shape.params.stride_rows -
+                         shape.params.padding_rows;
+        source_columns[j] = pixel % shape.output_width * shape.params.stride_columns -
+                            shape.params.padding_columns;
+    }
+
+    for (Index channel = 0; channel < shape.channels; ++channel) {
+        const T* plane = image + channel * shape.height * shape.width;
+
+        for (Index ky = 0; ky < shape.kernel_rows; ++ky) {
+            for (Index kx = 0; kx < shape.kernel_columns; ++kx) {
+                T* to = panel;
+                panel += kPanelWidth;
+
+                for (Index j = 0; j < width; ++j) {
+                    Index row = source_rows[j] + ky;
+                    Index column = source_columns[j] + kx;
+                    bool inside =
+                        0 <= row && row < shape.height && 0 <= column && column < shape.width;
+                    to[j] = inside ? plane[row * shape.width + column] : T{0};
+                }
+                std::fill(to + width, to + kPanelWidth, T{0});
+            }
+        }
+    }
+}
+
+//  Output pixels [first, last) of one image: the tile is packed panel by panel into buffer and
+//  multiplied by all filters with the packed kernel.
+template <class T>
+void ConvolveTile(const T* image, const Matrix<T>& filters, const Shape& shape, Index first,
+                  Index last, std::vector<T, MatrixAllocator<T>>* buffer, T* output) {
+    using detail_packed::kRowBlock;
+
+    constexpr Index kPanelWidth = detail_packed::kPanelWidth<T>;
+
+    Index inner = shape.Inner();
+    Index pixels = shape.Pixels();
+    Index panels = (last - first + kPanelWidth - 1) / kPanelWidth;
+
+    buffer->resize(panels * inner * kPanelWidth);
+    for (Index panel = 0; panel < panels; ++panel) {
+        Index begin = first + panel * kPanelWidth;
+        PackPanel(image, shape, begin, std::min(kPanelWidth, last - begin),
+                  buffer->data() + panel * inner * kPanelWidth);
+    }
+
+    for (Index filter = 0; filter < filters.Rows();) {
+        bool full = filter + kRowBlock <= filters.Rows();
+
+        for (Index panel = 0; panel < panels; ++panel) {
+            Index begin = first + panel * kPanelWidth;
+            Index width = std::min(kPanelWidth, last - begin);
+            const T* lhs = filters.Data() + filter * inner;
+            const T* packed = buffer->data() + panel * inner * kPanelWidth;
+            T* result = output + filter * pixels + begin;
+
+            if (full) {
+                detail_packed::MultiplyPanel<T, kRowBlock>(lhs, inner, packed, inner, result,
+                                                           pixels, width);
+            } else {
+                detail_packed::MultiplyPanel<T, 1>(lhs, inner, packed, inner, result, pixels,
+                                                   width);
+            }
+        }
+
+        filter += full ? kRowBlock : 1;
+    }
+}
+
+}  // namespace detail_convolution
+
+//  2D convolution (cross-correlation, as in CNNs) of input N x C x H x W with filters
+//  F x C x KH x KW, giving N x F x OH x OW with OH = (H + 2 * padding_rows - KH) / stride_rows + 1
+//  and the same for columns. Lowered to GEMM: filters (F x C * KH * KW) times the unrolled input,
+//  which is never built in full. Tiles of output pixels are unrolled straight into the packed
+//  panel layout, multiplied with the packed kernel and dropped, so the extra memory is one tile
+//  per thread. With an executor the tiles of all images are split between its threads.
+template <class T>
+Tensor<T> Conv2D(const Tensor<T>& input, const Tensor<T>& filters, Conv2DParams params = {},
+                 Executor* executor = nullptr) {
+    using detail_convolution::Index;
+    using detail_convolution::kTilePanels;
+
+    static_assert(std::is_arithmetic_v<T>, "Convolution uses the packed simd kernel");
+
+    assert(input.Channels() == filters.Channels());
+    assert(params.stride_rows > 0 && params.stride_columns > 0);
+    assert(params.padding_rows >= 0 && params.padding_columns >= 0);
+
+    Index padded_height = input.Height() + 2 * params.padding_rows;
+    Index padded_width = input.Width() + 2 * params.padding_columns;
+    assert(filters.Height() <= padded_height && filters.Width() <= padded_width);
+
+    detail_convolution::Shape shape{input.Channels(),
+                                    input.Height(),
+                                    input.Width(),
+                                    filters.Height(),
+                                    filters.Width(),
+                                    (padded_height - filters.Height()) / params.stride_rows + 1,
+                                    (padded_width - filters.Width()) / params.stride_columns + 1,
+                                    params};
+
+    //  F x C x KH x KW is already the row major F x (C * KH * KW) filter matrix.
+    Matrix<T> filter_matrix(filters.Batch(), shape.Inner(), kUninitialized);
+    std::copy(filters.Plane(0, 0), filters.Plane(0, 0) + filters.Batch() * shape.Inner(),
+              filter_matrix.Data());
+
+    Tensor<T> output(input.Batch(), filters.Batch(), shape.output_height, shape.output_width,
+                     kUninitialized);
+
+    Index tile = kTilePanels * detail_packed::kPanelWidth<T>;
+    Index tiles_per_image = (shape.Pixels() + tile - 1) / tile;
+
+    auto convolve = [&](Index tile_begin, Index tile_end) {
+        std::vector<T, MatrixAllocator<T>> buffer;
+
+        for (Index index = tile_begin; index < tile_end; ++index) {
+            Index image = index / tiles_per_image;
+            Index first = index % tiles_per_image * tile;
+            Index last = std::min(shape.Pixels(), first + tile);
+
+            detail_convolution::ConvolveTile(input.Plane(image, 0), filter_matrix, shape, first,
+                                             last, &buffer, output.Plane(image, 0));
+        }
+    };
+
+    Index tiles = input.Batch() * tiles_per_image;
+    Index chunks = executor == nullptr ? 1 : 4 * static_cast<Index>(executor->Concurrency());
+    ParallelFor(executor, tiles, std::max<Index>(1, tiles / chunks), convolve);
+
+    return output;
+}
+
+}  // namespace s_fast
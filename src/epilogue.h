@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "matrix.h"
+#include "utils.h"
+#include "xsimd/xsimd.hpp"
+
+namespace s_fast {
+
+namespace detail_epilogue {
+
+using Index = utils::Index;
+
+//  values[i] = op(values[i]) on simd batches; the tail goes through a zero padded batch.
+template <class T, class Op>
+void Transform(T* values, Index count, Op op) {
+    using SIMDtype = xsimd::batch<T>;
+
+    constexpr Index kRegisterSize = SIMDtype::size;
+
+    Index i = 0;
+    for (; i + kRegisterSize <= count; i += kRegisterSize) {
+        op(SIMDtype::load_unaligned(values + i)).store_unaligned(values + i);
+    }
+
+    if (i < count) {
+        T buffer[kRegisterSize] = {};
+        std::copy(values + i, values + count, buffer);
+        op(SIMDtype::load_unaligned(buffer)).store_unaligned(buffer);
+        std::copy(buffer, buffer + count - i, values + i);
+    }
+}
+
+//  values[i] = op(values[i], from[i]).
+template <class T, class Op>
+void Transform(T* values, const T* from, Index count, Op op) {
+    using SIMDtype = xsimd::batch<T>;
+
+    constexpr Index kRegisterSize = SIMDtype::size;
+
+    Index i = 0;
+    for (; i + kRegisterSize <= count; i += kRegisterSize) {
+        op(SIMDtype::load_unaligned(values + i), SIMDtype::load_unaligned(from + i))
+            .store_unaligned(values + i);
+    }
+
+    if (i < count) {
+        T buffer[kRegisterSize] = {};
+        T from_buffer[kRegisterSize] = {};
+        std::copy(values + i, values + count, buffer);
+        std::copy(from + i, from + count, from_buffer);
+        op(SIMDtype::load_unaligned(buffer), SIMDtype::load_unaligned(from_buffer))
+            .store_unaligned(buffer);
+        std::copy(buffer, buffer + count - i, values + i);
+    }
+}
+
+struct NoOp {
+    template <class T>
+    void operator()(T*, Index, Index, Index) const {
+    }
+};
+
+template <class T>
+struct ScaleOp {
+    T alpha;
+
+    void operator()(T* values, Index, Index, Index count) const {
+        xsimd::batch<T> alpha_vec(alpha);
+        Transform(values, count, [&](auto value) { return value * alpha_vec; });
+    }
+};
+
+template <class T>
+struct BiasColumnsOp {
+    const T* bias;
+
+    void operator()(T* values, Index, Index column, Index count) const {
+        Transform(values, bias + column, count, [](auto value, auto bias) { return value + bias; });
+    }
+};
+
+template <class T>
+struct BiasRowsOp {
+    const T* bias;
+
+    void operator()(T* values, Index row, Index, Index count) const {
+        xsimd::batch<T> bias_vec(bias[row]);
+        Transform(values, count, [&](auto value) { return value + bias_vec; });
+    }
+};
+
+template <class T>
+struct AddMatrixOp {
+    const Matrix<T>* matrix;
+    T beta;
+
+    void operator()(T* values, Index row, Index column, Index count) const {
+        xsimd::batch<T> beta_vec(beta);
+        const T* from = matrix->Data() + row * matrix->Columns() + column;
+        Transform(values, from, count,
+                  [&](auto value, auto addend) { return value + beta_vec * addend; });
+    }
+};
+
+struct ReluOp {
+    template <class T>
+    void operator()(T* values, Index, Index, Index count) const {
+        xsimd::batch<T> zero(T{0});
+        Transform(values, count, [&](auto value) { return xsimd::max(value, zero); });
+    }
+};
+
+template <class T>
+struct ClampOp {
+    T low;
+    T high;
+
+    void operator()(T* values, Index, Index, Index count) const {
+        xsimd::batch<T> low_vec(low);
+        xsimd::batch<T> high_vec(high);
+        Transform(values, count,
+                  [&](auto value) { return xsimd::min(xsimd::max(value, low_vec), high_vec); });
+    }
+};
+
+template <class Function>
+struct ElementwiseOp {
+    Function function;
+
+    template <class T>
+    void operator()(T* values, Index, Index, Index count) const {
+        for (Index i = 0; i < count; ++i) {
+            values[i] = function(values[i]);
+        }
+    }
+};
+
+template <class First, class Second>
+struct ComposedOp {
+    First first;
+    Second second;
+
+    template <class T>
+    void operator()(T* values, Index row, Index column, Index count) const {
+        first(values, row, column, count);
+        second(values, row, column, count);
+    }
+};
+
+}  // namespace detail_epilogue
+
+//  Operation fused into a multiplication: the engines that take one apply it to every piece of a
+//  result row as soon as it is final, while the piece is still in cache, instead of a separate
+//  pass over the result per operation. op(values, row, column, count) gets the result elements
+//  (row, column) ... (row, column + count - 1) and changes them in place. Epilogues are combined
+//  with Then and applied left to right:
+//
+//      SimdMultiplication(x, weights, BiasColumns(bias).Then(Relu()));
+template <class Op>
+class Epilogue {
+public:
+    using Index = utils::Index;
+
+    explicit Epilogue(Op op) : op_(std::move(op)) {
+    }
+
+    template <class T>
+    void operator()(T* values, Index row, Index column, Index count) const {
+        op_(values, row, column, count);
+    }
+
+    template <class Next>
+    Epilogue<detail_epilogue::ComposedOp<Op, Next>> Then(const Epilogue<Next>& next) const {
+        return Epilogue<detail_epilogue::ComposedOp<Op, Next>>({op_, next.op_});
+    }
+
+    //  Applies the epilogue to rows [row_begin, row_end) of a finished result.
+    template <class T>
+    void ApplyRows(Matrix<T>* result, Index row_begin, Index row_end) const {
+        for (Index row = row_begin; row < row_end; ++row) {
+            op_(result->Data() + row * result->Columns(), row, 0, result->Columns());
+        }
+    }
+
+private:
+    template <class Other>
+    friend class Epilogue;
+
+    Op op_;
+};
+
+inline Epilogue<detail_epilogue::NoOp> NoEpilogue() {
+    return Epilogue<detail_epilogue::NoOp>({});
+}
+
+//  result *= alpha.
+template <class T>
+Epilogue<detail_epilogue::ScaleOp<T>> Scale(T alpha) {
+    return Epilogue<detail_epilogue::ScaleOp<T>>({alpha});
+}
+
+//  result(i, j) += bias[j], as in a linear layer. bias must outlive the multiplication.
+template <class T>
+Epilogue<detail_epilogue::BiasColumnsOp<T>> BiasColumns(const std::vector<T>& bias) {
+    return Epilogue<detail_epilogue::BiasColumnsOp<T>>({bias.data()});
+}
+
+//  result(i, j) += bias[i]. bias must outlive the multiplication.
+template <class T>
+Epilogue<detail_epilogue::BiasRowsOp<T>> BiasRows(const std::vector<T>& bias) {
+    return Epilogue<detail_epilogue::BiasRowsOp<T>>({bias.data()});
+}
+
+//  result += beta * matrix, e.g. accumulation into an existing product. matrix has the shape of
+//  the result and must outlive the multiplication.
+template <class T>
+Epilogue<detail_epilogue::AddMatrixOp<T>> AddMatrix(const Matrix<T>& matrix, T beta = T{1}) {
+    return Epilogue<detail_epilogue::AddMatrixOp<T>>({&matrix, beta});
+}
+
+inline Epilogue<detail_epilogue::ReluOp> Relu() {
+    return Epilogue<detail_epilogue::ReluOp>({});
+}
+
+template <class T>
+Epilogue<detail_epilogue::ClampOp<T>> Clamp(T low, T high) {
+    assert(low <= high);
+
+    return Epilogue<detail_epilogue::ClampOp<T>>({low, high});
+}
+
+//  Any other elementwise function, value -> function(value), applied one element at a time.
+template <class Function>
+Epilogue<detail_epilogue::ElementwiseOp<Function>> Elementwise(Function function) {
+    return Epilogue<detail_epilogue::ElementwiseOp<Function>>({std::move(function)});
+}
+
+}  // namespace s_fast
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "numa.h"
+
+namespace s_fast {
+
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+    virtual ~Executor() = default;
+
+    virtual void Submit(Task task) = 0;
+
+    //  Submits the task that processes part `part` of `parts` equal consecutive parts of some data.
+    //  Executors that know where memory lives use it to run the task close to its part.
+    virtual void SubmitPart(Task task, int64_t part, int64_t parts) {
+        (void)part;
+        (void)parts;
+        Submit(std::move(task));
+    }
+
+    virtual size_t Concurrency() const = 0;
+};
+
+class ThreadPool : public Executor {
+public:
+    explicit ThreadPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
+        : ThreadPool(threads, {}) {
+    }
+
+    //  Workers are pinned to the given CPUs; an empty list leaves them unpinned.
+    ThreadPool(size_t threads, const std::vector<int>& cpus) {
+        assert(threads > 0);
+
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, cpus] {
+                detail_numa::PinCurrentThread(cpus);
+                Work();
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() override {
+        {
+            std::lock_guard lock(mutex_);
+            stopped_ = true;
+        }
+        has_task_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void Submit(Task task) override {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        has_task_.notify_one();
+    }
+
+    size_t Concurrency() const override {
+        return workers_.size();
+    }
+
+private:
+    void Work() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock lock(mutex_);
+                has_task_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+
+                if (tasks_.empty()) {
+                    return;
+                }
+
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<Task> tasks_;
+    std::mutex mutex_;
+    std::condition_variable has_task_;
+    bool stopped_ = false;
+};
+
+//  One ThreadPool per NUMA node with as many threads as the node has CPUs, pinned to them.
+//  SubmitPart sends part i of n to node i * nodes / n, so rows first touched by ParallelFor on
+//  this pool are later computed by the node whose memory they were placed in.
+class NumaThreadPool : public Executor {
+public:
+    NumaThreadPool() : NumaThreadPool(detail_numa::NodeCpus()) {
+    }
+
+    //  node_cpus[i] lists the CPUs of node i; an empty list means one unpinned thread per hardware
+    //  thread.
+    explicit NumaThreadPool(const std::vector<std::vector<int>>& node_cpus) {
+        assert(!node_cpus.empty());
+
+        for (const auto& cpus : node_cpus) {
+            size_t threads = cpus.empty()
+                                 ? std::max<size_t>(1, std::thread::hardware_concurrency())
+                                 : cpus.size();
+            nodes_.push_back(std::make_unique<ThreadPool>(threads, cpus));
+        }
+    }
+
+    void Submit(Task task) override {
+        nodes_[next_node_.fetch_add(1) % nodes_.size()]->Submit(std::move(task));
+    }
+
+    void SubmitPart(Task task, int64_t part, int64_t parts) override {
+        assert(0 <= part && part < parts);
+
+        nodes_[part * static_cast<int64_t>(nodes_.size()) / parts]->Submit(std::move(task));
+    }
+
+    size_t Concurrency() const override {
+        size_t threads = 0;
+        for (const auto& node : nodes_) {
+            threads += node->Concurrency();
+        }
+        return threads;
+    }
+
+    size_t Nodes() const {
+        return nodes_.size();
+    }
+
+private:
+    std::vector<std::unique_ptr<ThreadPool>> nodes_;
+    std::atomic<size_t> next_node_ = 0;
+};
+
+//  Runs every task inline on the submitting thread. Passing it to an engine makes the call
+//  single threaded without a separate code path, e.g. on a thread that is already a pool worker.
+class SerialExecutor : public Executor {
+public:
+    void Submit(Task task) override {
+        task();
+    }
+
+    size_t Concurrency() const override {
+        return 1;
+    }
+};
+
+//  Runs tasks on another executor, at most `limit` of them at a time, so concurrent calls sharing
+//  one pool get a predictable part of it. Tasks over the limit wait in a queue and are run by the
+//  tasks already in flight as those finish. Waits for its tasks on destruction.
+class LimitedExecutor : public Executor {
+public:
+    LimitedExecutor(Executor& base, size_t limit) : base_(base), limit_(limit) {
+        assert(limit > 0);
+    }
+
+    LimitedExecutor(const LimitedExecutor&) = delete;
+    LimitedExecutor& operator=(const LimitedExecutor&) = delete;
+
+    ~LimitedExecutor() override {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return running_ == 0; });
+    }
+
+    void Submit(Task task) override {
+        if (Enqueue(&task)) {
+            base_.Submit(Wrap(std::move(task)));
+        }
+    }
+
+    void SubmitPart(Task task, int64_t part, int64_t parts) override {
+        if (Enqueue(&task)) {
+            base_.SubmitPart(Wrap(std::move(task)), part, parts);
+        }
+    }
+
+    size_t Concurrency() const override {
+        return std::min(limit_, base_.Concurrency());
+    }
+
+private:
+    //  Takes a slot for the task, or queues it and returns false if all slots are taken.
+    bool Enqueue(Task* task) {
+        std::lock_guard lock(mutex_);
+        if (running_ == limit_) {
+            waiting_.push(std::move(*task));
+            return false;
+        }
+        ++running_;
+        return true;
+    }
+
+    Task Wrap(Task task) {
+        return [this, task = std::move(task)]() mutable {
+            while (true) {
+                task();
+
+                std::lock_guard lock(mutex_);
+                if (waiting_.empty()) {
+                    --running_;
+                    idle_.notify_all();
+                    return;
+                }
+                task = std::move(waiting_.front());
+                waiting_.pop();
+            }
+        };
+    }
+
+    Executor& base_;
+    size_t limit_;
+    size_t running_ = 0;
+    std::queue<Task> waiting_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+};
+
+//  Splits [0, size) into chunks of at most grain elements, runs body(begin, end) for each of them
+//  on the executor and waits for all of them. Chunks are submitted with SubmitPart, so a NUMA
+//  aware executor maps every range of [0, size) to the same node on every call, up to one chunk
+//  at node boundaries. Must not be called from the executor's own tasks.
+template <class Body>
+void ParallelFor(Executor& executor, int64_t size, int64_t grain, Body body) {
+    assert(grain > 0);
+
+    int64_t chunks = (size + grain - 1) / grain;
+    if (chunks <= 1) {
+        if (size > 0) {
+            body(int64_t{0}, size);
+        }
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    int64_t chunks_left = chunks;
+    std::exception_ptr error;
+
+    for (int64_t begin = 0; begin < size; begin += grain) {
+        int64_t end = std::min(size, begin + grain);
+
+        Executor::Task chunk = [&, begin, end] {
+            std::exception_ptr chunk_error;
+            try {
+                body(begin, end);
+            } catch (...) {
+                chunk_error = std::current_exception();
+            }
+
+            std::lock_guard lock(mutex);
+            if (chunk_error && !error) {
+                error = chunk_error;
+            }
+            if (--chunks_left == 0) {
+                done.notify_one();
+            }
+        };
+        executor.SubmitPart(std::move(chunk), begin / grain, chunks);
+    }
+
+    std::unique_lock lock(mutex);
+    done.wait(lock, [&] { return chunks_left == 0; });
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+//  Same with an optional executor: without one the whole range is a single inline chunk.
+template <class Body>
+void ParallelFor(Executor* executor, int64_t size, int64_t grain, Body body) {
+    if (executor != nullptr) {
+        ParallelFor(*executor, size, grain, std::move(body));
+    } else if (size > 0) {
+        body(int64_t{0}, size);
+    }
+}
+
+//  Library-managed pool, created on first use and shared by calls without an explicit executor.
+//  On multi-socket hosts it has its threads pinned per NUMA node.
+inline Executor& DefaultExecutor() {
+    static NumaThreadPool pool;
+    return pool;
+}
+
+}  // namespace s_fast
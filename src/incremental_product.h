@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "simd_multiplication.h"
+#include "strassen.h"
+#include "utils.h"
+
+namespace s_fast {
+
+//  Keeps product = lhs * rhs up to date while the operands change a little at a time. Replacing
+//  rows of lhs or columns of rhs recomputes just those rows or columns of the product, and a
+//  rank r update of either operand is applied to the product as two thin products. Every update
+//  costs time proportional to the part of the product it changes (times the inner dimension or
+//  r), never a full multiplication. Products are computed with the executor given on
+//  construction, if any.
+//
+//  Low-rank updates accumulate rounding in floating point products; Recompute starts over.
+template <class T>
+class IncrementalProduct {
+public:
+    using Index = typename Matrix<T>::Index;
+
+    IncrementalProduct(Matrix<T> lhs, Matrix<T> rhs, Executor* executor = nullptr)
+        : lhs_(std::move(lhs)), rhs_(std::move(rhs)), executor_(executor) {
+        assert(lhs_.Columns() == rhs_.Rows());
+
+        Recompute();
+    }
+
+    const Matrix<T>& Lhs() const {
+        return lhs_;
+    }
+
+    const Matrix<T>& Rhs() const {
+        return rhs_;
+    }
+
+    const Matrix<T>& Product() const {
+        return product_;
+    }
+
+    //  Full multiplication with Strassen.
+    void Recompute() {
+        product_ = Strassen(lhs_, rhs_, executor_);
+    }
+
+    //  lhs row rows[i] = values row i; product rows rows[i] = values row i * rhs.
+    void SetLhsRows(const std::vector<Index>& rows, const Matrix<T>& values) {
+        assert(values.Rows() == static_cast<Index>(rows.size()));
+        assert(values.Columns() == lhs_.Columns());
+
+        SimdMultiplication(values, rhs_, &buffer_, executor_);
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            assert(0 <= rows[i] && rows[i] < lhs_.Rows());
+
+            std::copy(values.Data() + i * values.Columns(),
+                      values.Data() + (i + 1) * values.Columns(),
+                      lhs_.Data() + rows[i] * lhs_.Columns());
+            std::copy(buffer_.Data() + i * buffer_.Columns(),
+                      buffer_.Data() + (i + 1) * buffer_.Columns(),
+                      product_.Data() + rows[i] * product_.Columns());
+        }
+    }
+
+    //  rhs column columns[j] = values column j; product columns columns[j] = lhs * values column j.
+    void SetRhsColumns(const std::vector<Index>& columns, const Matrix<T>& values) {
+        assert(values.Columns() == static_cast<Index>(columns.size()));
+        assert(values.Rows() == rhs_.Rows());
+
+        SimdMultiplication(lhs_, values, &buffer_, executor_);
+
+        for (Index column : columns) {
+            assert(0 <= column && column < rhs_.Columns());
+        }
+
+        for (Index row = 0; row < rhs_.Rows(); ++row) {
+            for (size_t j = 0; j < columns.size(); ++j) {
+                rhs_(row, columns[j]) = values(row, j);
+            }
+        }
+
+        for (Index row = 0; row < product_.Rows(); ++row) {
+            for (size_t j = 0; j < columns.size(); ++j) {
+                product_(row, columns[j]) = buffer_(row, j);
+            }
+        }
+    }
+
+    //  lhs += u * v for u of lhs.Rows() x r and v of r x lhs.Columns():
+    //  product += u * (v * rhs).
+    void UpdateLhs(const Matrix<T>& u, const Matrix<T>& v) {
+        assert(u.Rows() == lhs_.Rows() && v.Columns() == lhs_.Columns());
+        assert(u.Columns() == v.Rows());
+
+        SimdMultiplication(v, rhs_, &buffer_, executor_);
+        product_ += SimdMultiplication(u, buffer_, executor_);
+
+        SimdMultiplication(u, v, &buffer_, executor_);
+        lhs_ += buffer_;
+    }
+
+    //  rhs += u * v for u of rhs.Rows() x r and v of r x rhs.Columns():
+    //  product += (lhs * u) * v.
+    void UpdateRhs(const Matrix<T>& u, const Matrix<T>& v) {
+        assert(u.Rows() == rhs_.Rows() && v.Columns() == rhs_.Columns());
+        assert(u.Columns() == v.Rows());
+
+        SimdMultiplication(lhs_, u, &buffer_, executor_);
+        product_ += SimdMultiplication(buffer_, v, executor_);
+
+        SimdMultiplication(u, v, &buffer_, executor_);
+        rhs_ += buffer_;
+    }
+
+private:
+    Matrix<T> lhs_;
+    Matrix<T> rhs_;
+    Matrix<T> product_;
+    //  Scratch for the thin products, reused between updates.
+    Matrix<T> buffer_;
+    Executor* executor_;
+};
+
+}  // namespace s_fast
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "simd_multiplication.h"
+#include "symmetric_multiplication.h"
+#include "utils.h"
+
+namespace s_fast {
+
+//  Whether a triangular matrix has an implicit unit diagonal (the L factor of LU) or uses the
+//  stored one.
+enum class Diagonal { kNonUnit, kUnit };
+
+namespace detail_lu {
+
+using Index = utils::Index;
+
+//  Panels and triangular blocks up to this size are solved with row operations, larger ones are
+//  halved and their off-diagonal part is updated with a matrix product.
+constexpr Index kBlockSize = 64;
+
+struct Range {
+    Index begin;
+    Index end;
+
+    Index Size() const {
+        return end - begin;
+    }
+};
+
+//  target[rows, columns] -= lhs[rows, inner] * rhs[inner, columns], accumulated in place by the
+//  packed kernel: lhs is read where it is, the rhs block is packed once, and the executor's
+//  threads take row blocks of target. The operands may be blocks of target itself as long as they
+//  do not overlap the updated block.
+template <class T>
+void SubtractProduct(const Matrix<T>& lhs, const Matrix<T>& rhs, Range rows, Range inner,
+                     Range columns, Matrix<T>* target, Executor* executor) {
+    using utils::kAsyncRowBlockSize;
+
+    if (rows.Size() == 0 || inner.Size() == 0 || columns.Size() == 0) {
+        return;
+    }
+
+    PackedMatrix<T> packed(rhs.Data() + inner.begin * rhs.Columns() + columns.begin,
+                           rhs.Columns(), inner.Size(), columns.Size());
+    const T* lhs_block = lhs.Data() + rows.begin * lhs.Columns() + inner.begin;
+    T* target_block = target->Data() + rows.begin * target->Columns() + columns.begin;
+
+    ParallelFor(executor, rows.Size(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_packed::AccumulateRows(lhs_block, lhs.Columns(), packed, T{-1}, begin, end,
+                                      target_block, target->Columns());
+    });
+}
+
+//  Solves l[rows, rows] * x = b[rows, columns] in place for lower triangular l: the top half is
+//  solved, the product with it is subtracted from the bottom half, then the bottom half is solved.
+template <class T>
+void SolveLower(const Matrix<T>& l, Diagonal diagonal, Range rows, Range columns, Matrix<T>* b,
+                Executor* executor) {
+    if (rows.Size() <= kBlockSize) {
+        for (Index row = rows.begin; row < rows.end; ++row) {
+            T* b_row = b->Data() + row * b->Columns() + columns.begin;
+
+            for (Index k = rows.begin; k < row; ++k) {
+                detail_simd::Axpy(-l(row, k), b->Data() + k * b->Columns() + columns.begin, b_row,
+                                  columns.Size());
+            }
+            if (diagonal == Diagonal::kNonUnit) {
+                T scale = T{1} / l(row, row);
+                std::transform(b_row, b_row + columns.Size(), b_row,
+                               [scale](T value) { return value * scale; });
+            }
+        }
+        return;
+    }
+
+    Index middle = rows.begin + rows.Size() / 2;
+
+    SolveLower(l, diagonal, {rows.begin, middle}, columns, b, executor);
+    SubtractProduct(l, *b, {middle, rows.end}, {rows.begin, middle}, columns, b, executor);
+    SolveLower(l, diagonal, {middle, rows.end}, columns, b, executor);
+}
+
+//  Same for upper triangular u, bottom half first.
+template <class T>
+void SolveUpper(const Matrix<T>& u, Diagonal diagonal, Range rows, Range columns, Matrix<T>* b,
+                Executor* executor) {
+    if (rows.Size() <= kBlockSize) {
+        for (Index row = rows.end - 1; row >= rows.begin; --row) {
+            T* b_row = b->Data() + row * b->Columns() + columns.begin;
+
+            for (Index k = row + 1; k < rows.end; ++k) {
+                detail_simd::Axpy(-u(row, k), b->Data() + k * b->Columns() + columns.begin, b_row,
+                                  columns.Size());
+            }
+            if (diagonal == Diagonal::kNonUnit) {
+                T scale = T{1} / u(row, row);
+                std::transform(b_row, b_row + columns.Size(), b_row,
+                               [scale](T value) { return value * scale; });
+            }
+        }
+        return;
+    }
+
+    Index middle = rows.begin + rows.Size() / 2;
+
+    SolveUpper(u, diagonal, {middle, rows.end}, columns, b, executor);
+    SubtractProduct(u, *b, {rows.begin, middle}, {middle, rows.end}, columns, b, executor);
+    SolveUpper(u, diagonal, {rows.begin, middle}, columns, b, executor);
+}
+
+template <class T>
+void SwapRows(Matrix<T>* matrix, Index lhs, Index rhs) {
+    Index columns = matrix->Columns();
+    std::swap_ranges(matrix->Data() + lhs * columns, matrix->Data() + (lhs + 1) * columns,
+                     matrix->Data() + rhs * columns);
+}
+
+//  Unblocked LU with partial pivoting of columns [columns.begin, columns.end) and rows from
+//  columns.begin down. Pivot rows are swapped across the whole matrix. Returns false if some
+//  pivot is zero; that column is left as is.
+template <class T>
+bool FactorPanel(Range columns, Matrix<T>* a, std::vector<Index>* pivots) {
+    Index size = a->Rows();
+    bool regular = true;
+
+    for (Index k = columns.begin; k < columns.end; ++k) {
+        Index pivot = k;
+        for (Index row = k + 1; row < size; ++row) {
+            if (std::abs((*a)(row, k)) > std::abs((*a)(pivot, k))) {
+                pivot = row;
+            }
+        }
+
+        (*pivots)[k] = pivot;
+        if (pivot != k) {
+            SwapRows(a, k, pivot);
+        }
+
+        if ((*a)(k, k) == T{0}) {
+            regular = false;
+            continue;
+        }
+
+        T scale = T{1} / (*a)(k, k);
+        const T* pivot_row = a->Data() + k * size + k + 1;
+
+        for (Index row = k + 1; row < size; ++row) {
+            T& l = (*a)(row, k);
+            l *= scale;
+            detail_simd::Axpy(-l, pivot_row, a->Data() + row * size + k + 1, columns.end - k - 1);
+        }
+    }
+
+    return regular;
+}
+
+//  Recursive LU of columns [columns.begin, columns.end), rows from columns.begin down: the left
+//  half is factored, the top right block is solved with its unit lower triangle, the Schur
+//  complement of the bottom right block is updated with one large product, and the right half is
+//  factored. Most of the flops end up in these products.
+template <class T>
+bool Factor(Range columns, Matrix<T>* a, std::vector<Index>* pivots, Executor* executor) {
+    if (columns.Size() <= kBlockSize) {
+        return FactorPanel(columns, a, pivots);
+    }
+
+    Index middle = columns.begin + columns.Size() / 2;
+    Range left = {columns.begin, middle};
+    Range right = {middle, columns.end};
+
+    bool regular = Factor(left, a, pivots, executor);
+    SolveLower(*a, Diagonal::kUnit, left, right, a, executor);
+    SubtractProduct(*a, *a, {middle, a->Rows()}, left, right, a, executor);
+
+    return Factor(right, a, pivots, executor) && regular;
+}
+
+}  // namespace detail_lu
+
+//  Solves triangular * x = rhs, reading only the given triangle of the square matrix. Blocks
+//  larger than 64 rows are split in halves and the off-diagonal part goes through the same
+//  engines as the products, with the executor if one is given.
+template <class T>
+Matrix<T> SolveTriangular(const Matrix<T>& triangular, Triangle triangle, const Matrix<T>& rhs,
+                          Diagonal diagonal = Diagonal::kNonUnit, Executor* executor = nullptr) {
+    static_assert(std::is_floating_point_v<T>, "Triangular solves need division");
+
+    assert(triangular.Rows() == triangular.Columns());
+    assert(triangular.Columns() == rhs.Rows());
+
+    Matrix<T> result = rhs;
+    detail_lu::Range rows = {0, rhs.Rows()};
+    detail_lu::Range columns = {0, rhs.Columns()};
+
+    if (triangle == Triangle::kLower) {
+        detail_lu::SolveLower(triangular, diagonal, rows, columns, &result, executor);
+    } else {
+        detail_lu::SolveUpper(triangular, diagonal, rows, columns, &result, executor);
+    }
+
+    return result;
+}
+
+//  LU factorization with partial pivoting, P * a = L * U, of a square floating point matrix.
+//  The factorization is recursive, so its Schur complement updates are large products done by
+//  the simd engine and inherit its speed and the executor. A zero pivot marks the matrix
+//  singular; Solve then throws.
+template <class T>
+class LUDecomposition {
+public:
+    using Index = utils::Index;
+
+    static_assert(std::is_floating_point_v<T>, "LU needs division and pivoting by magnitude");
+
+    explicit LUDecomposition(Matrix<T> matrix, Executor* executor = nullptr)
+        : factors_(std::move(matrix)), pivots_(factors_.Rows()) {
+        assert(factors_.Rows() == factors_.Columns());
+
+        regular_ = detail_lu::Factor({0, factors_.Rows()}, &factors_, &pivots_, executor);
+    }
+
+    Index Size() const {
+        return factors_.Rows();
+    }
+
+    bool Singular() const {
+        return !regular_;
+    }
+
+    //  L below the diagonal (its unit diagonal is not stored) and U on and above it.
+    const Matrix<T>& Factors() const {
+        return factors_;
+    }
+
+    //  Row i of the matrix was swapped with row Pivots()[i] >= i, in order of i.
+    const std::vector<Index>& Pivots() const {
+        return pivots_;
+    }
+
+    T Determinant() const {
+        T determinant = 1;
+
+        for (Index i = 0; i < Size(); ++i) {
+            determinant *= pivots_[i] == i ? factors_(i, i) : -factors_(i, i);
+        }
+
+        return determinant;
+    }
+
+    //  x with matrix * x = rhs.
+    Matrix<T> Solve(const Matrix<T>& rhs, Executor* executor = nullptr) const {
+        assert(rhs.Rows() == Size());
+
+        if (Singular()) {
+            throw std::runtime_error("LUDecomposition::Solve: singular matrix");
+        }
+
+        Matrix<T> result = rhs;
+        for (Index i = 0; i < Size(); ++i) {
+            if (pivots_[i] != i) {
+                detail_lu::SwapRows(&result, i, pivots_[i]);
+            }
+        }
+
+        detail_lu::Range rows = {0, Size()};
+        detail_lu::Range columns = {0, rhs.Columns()};
+        detail_lu::SolveLower(factors_, Diagonal::kUnit, rows, columns, &result, executor);
+        detail_lu::SolveUpper(factors_, Diagonal::kNonUnit, rows, columns, &result, executor);
+
+        return result;
+    }
+
+private:
+    Matrix<T> factors_;
+    std::vector<Index> pivots_;
+    bool regular_ = true;
+};
+
+//  Inverse of a square floating point matrix, as the solution of matrix * x = identity.
+//  Throws std::runtime_error if the matrix is singular.
+template <class T>
+Matrix<T> Inverse(const Matrix<T>& matrix, Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+
+    Matrix<T> identity(matrix.Rows(), matrix.Rows());
+    for (Index i = 0; i < matrix.Rows(); ++i) {
+        identity(i, i) = 1;
+    }
+
+    return LUDecomposition<T>(matrix, executor).Solve(identity, executor);
+}
+
+}  // namespace s_fast
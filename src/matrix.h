@@ -1,19 +1,23 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <ostream>
 #include <random>
+#include <utility>
 #include <vector>
 
+#include "executor.h"
 #include "helper.h"
+#include "matrix_storage.h"
 
 namespace s_fast {
 
-template <class T>
-class Matrix;
+//  Tag of constructors that leave the elements unwritten, for callers that overwrite all of them.
+struct Uninitialized {};
 
-template <class T>
-Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs);
+constexpr Uninitialized kUninitialized{};
 
 template <class T>
 class Matrix {
@@ -43,15 +47,25 @@ public:
         return *this;
     }
 
-    explicit Matrix(Index n) : data_(n * n, 0), columns_(n) {
+    explicit Matrix(Index n) : Matrix(n, n) {
+    }
+
+    Matrix(Index rows, Index columns) {
+        Reset(rows, columns);
+    }
+
+    Matrix(Index rows, Index columns, Uninitialized) {
+        Reset(rows, columns, kUninitialized);
     }
 
-    Matrix(Index rows, Index columns) : data_(rows * columns, 0), columns_(columns) {
+    //  Zero filled by the executor's threads (first touch), see Reset(rows, columns, executor).
+    Matrix(Index rows, Index columns, Executor& executor) {
+        Reset(rows, columns, executor);
     }
 
     Matrix(std::initializer_list<std::initializer_list<T>> data)
-        : data_(std::empty(data) ? 0 : data.size() * data.begin()->size()),
-          columns_(std::empty(data) ? 0 : data.begin()->size()) {
+        : columns_(std::empty(data) ? 0 : data.begin()->size()) {
+        data_.AssignUninitialized(data.size() * columns_);
 
         Index i = 0;
 
@@ -65,7 +79,7 @@ public:
     }
 
     Index Rows() const {
-        return columns_ == 0 ? 0 : data_.size() / columns_;
+        return columns_ == 0 ? 0 : data_.Size() / columns_;
     }
 
     Index Columns() const {
@@ -84,10 +98,43 @@ public:
         return data_[row * Columns() + column];
     }
 
+    //  Reshapes to rows x columns filled with zeros, reusing the allocated storage when it fits.
+    void Reset(Index rows, Index columns) {
+        data_.Assign(rows * columns, T(0));
+        columns_ = columns;
+    }
+
+    //  Same, but the elements are left unwritten.
+    void Reset(Index rows, Index columns, Uninitialized) {
+        data_.AssignUninitialized(rows * columns);
+        columns_ = columns;
+    }
+
+    //  Same, but the zeros are written by the executor in row blocks. The kernel places each new
+    //  page on the NUMA node of the thread that touches it first, which is the node that will get
+    //  these rows when a parallel engine splits the rows on the same executor.
+    void Reset(Index rows, Index columns, Executor& executor) {
+        Reset(rows, columns, kUninitialized);
+
+        Index threads = static_cast<Index>(executor.Concurrency());
+        Index grain = std::max<Index>(1, (rows + threads - 1) / threads);
+        ParallelFor(executor, rows, grain, [this, columns](Index begin, Index end) {
+            std::fill(Data() + begin * columns, Data() + end * columns, T(0));
+        });
+    }
+
+    T* Data() {
+        return data_.Data();
+    }
+
+    const T* Data() const {
+        return data_.Data();
+    }
+
     Matrix& operator+=(const Matrix& other) {
         assert(Rows() == other.Rows() && Columns() == other.Columns());
 
-        for (size_t i = 0; i < data_.size(); ++i) {
+        for (size_t i = 0; i < data_.Size(); ++i) {
             data_[i] += other.data_[i];
         }
 
@@ -97,7 +144,7 @@ public:
     Matrix<T>& operator-=(const Matrix<T>& other) {
         assert(Rows() == other.Rows() && Columns() == other.Columns());
 
-        for (size_t i = 0; i < data_.size(); ++i) {
+        for (size_t i = 0; i < data_.Size(); ++i) {
             data_[i] -= other.data_[i];
         }
 
@@ -105,7 +152,7 @@ public:
     }
 
     Matrix<T>& operator*=(const T& element) {
-        for (size_t i = 0; i < data_.size(); ++i) {
+        for (size_t i = 0; i < data_.Size(); ++i) {
             data_[i] *= element;
         }
 
@@ -157,10 +204,8 @@ private:
         return lhs.Rows() == rhs.Rows() && lhs.Columns() == rhs.Columns() && lhs.data_ == rhs.data_;
     }
 
-    friend Matrix SimdMultiplication<T>(const Matrix&, const Matrix&);
-
 private:
-    std::vector<T> data_;
+    MatrixStorage<T> data_;
     Index columns_ = 0;
 };
 
@@ -171,16 +216,21 @@ bool operator!=(const Matrix<T>& lhs, const Matrix<T>& rhs) {
 
 //  TODO: cache-oblivious transpose
 template <class T>
-Matrix<T> Transpose(const Matrix<T>& other) {
+void Transpose(const Matrix<T>& other, Matrix<T>* transpose) {
     using Index = typename Matrix<T>::Index;
-    Matrix<T> transpose(other.Columns(), other.Rows());
+    assert(transpose->Rows() == other.Columns() && transpose->Columns() == other.Rows());
 
     for (Index row = 0; row < other.Rows(); ++row) {
         for (Index column = 0; column < other.Columns(); ++column) {
-            transpose(column, row) = other(row, column);
+            (*transpose)(column, row) = other(row, column);
         }
     }
+}
 
+template <class T>
+Matrix<T> Transpose(const Matrix<T>& other) {
+    Matrix<T> transpose(other.Columns(), other.Rows(), kUninitialized);
+    Transpose(other, &transpose);
     return transpose;
 }
 
@@ -201,7 +251,7 @@ Matrix<T> Random(typename Matrix<T>::Index rows, typename Matrix<T>::Index colum
                  Distribution distribution, uint64_t random_seed = 42) {
     using Index = typename Matrix<T>::Index;
 
-    Matrix<T> random_matrix(rows, columns);
+    Matrix<T> random_matrix(rows, columns, kUninitialized);
     std::mt19937 random(random_seed);
 
     for (Index i = 0; i < rows; ++i) {
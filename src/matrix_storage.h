@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "allocator.h"
+
+namespace s_fast {
+
+namespace detail_storage {
+
+//  Bytes of elements kept inside the object itself, e.g. a 4x4 matrix of doubles.
+constexpr size_t kInlineBytes = 128;
+
+}  // namespace detail_storage
+
+//  Contiguous element buffer of Matrix. Up to kInlineCapacity elements live in the object, so
+//  small temporaries never touch the heap; larger buffers come from the matrix allocator and are
+//  reused while they are big enough.
+template <class T>
+class MatrixStorage {
+public:
+    static constexpr size_t kInlineCapacity =
+        std::max<size_t>(1, detail_storage::kInlineBytes / sizeof(T));
+
+    MatrixStorage() = default;
+
+    MatrixStorage(const MatrixStorage& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.data_, other.size_, data_);
+        size_ = other.size_;
+    }
+
+    MatrixStorage(MatrixStorage&& other) noexcept {
+        Steal(&other);
+    }
+
+    MatrixStorage& operator=(const MatrixStorage& other) {
+        if (this != &other) {
+            Clear();
+            Reserve(other.size_);
+            std::uninitialized_copy_n(other.data_, other.size_, data_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    MatrixStorage& operator=(MatrixStorage&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            Release();
+            Steal(&other);
+        }
+        return *this;
+    }
+
+    ~MatrixStorage() {
+        Clear();
+        Release();
+    }
+
+    //  size elements equal to value.
+    void Assign(size_t size, const T& value) {
+        Clear();
+        Reserve(size);
+        std::uninitialized_fill_n(data_, size, value);
+        size_ = size;
+    }
+
+    //  size default-initialized elements: numbers are left unwritten.
+    void AssignUninitialized(size_t size) {
+        Clear();
+        Reserve(size);
+        std::uninitialized_default_construct_n(data_, size);
+        size_ = size;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    T* Data() {
+        return data_;
+    }
+
+    const T* Data() const {
+        return data_;
+    }
+
+    T& operator[](size_t index) {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return data_[index];
+    }
+
+    bool IsInline() const {
+        return data_ == InlineData();
+    }
+
+    friend bool operator==(const MatrixStorage& lhs, const MatrixStorage& rhs) {
+        return std::equal(lhs.data_, lhs.data_ + lhs.size_, rhs.data_, rhs.data_ + rhs.size_);
+    }
+
+private:
+    T* InlineData() {
+        return reinterpret_cast<T*>(buffer_);
+    }
+
+    const T* InlineData() const {
+        return reinterpret_cast<const T*>(buffer_);
+    }
+
+    //  Makes room for size elements; the buffer must hold no elements.
+    void Reserve(size_t size) {
+        assert(size_ == 0);
+
+        if (size <= capacity_) {
+            return;
+        }
+
+        T* data = static_cast<T*>(detail_allocator::Allocate(size * sizeof(T)));
+        Release();
+        data_ = data;
+        capacity_ = size;
+    }
+
+    void Clear() {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    //  Returns a heap buffer, if any, to the allocator; the buffer must hold no elements.
+    void Release() {
+        if (!IsInline()) {
+            detail_allocator::Deallocate(data_, capacity_ * sizeof(T));
+            data_ = InlineData();
+            capacity_ = kInlineCapacity;
+        }
+    }
+
+    //  Takes the elements of other and leaves it empty and inline. This must hold no elements and
+    //  no heap buffer.
+    void Steal(MatrixStorage* other) noexcept {
+        if (other->IsInline()) {
+            std::uninitialized_move_n(other->data_, other->size_, data_);
+            size_ = other->size_;
+            other->Clear();
+            return;
+        }
+
+        data_ = std::exchange(other->data_, other->InlineData());
+        size_ = std::exchange(other->size_, 0);
+        capacity_ = std::exchange(other->capacity_, kInlineCapacity);
+    }
+
+    alignas(T) unsigned char buffer_[kInlineCapacity * sizeof(T)];
+    T* data_ = InlineData();
+    size_t size_ = 0;
+    size_t capacity_ = kInlineCapacity;
+};
+
+}  // namespace s_fast
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "utils.h"
+#include "xsimd/xsimd.hpp"
+
+namespace s_fast {
+
+namespace detail_modular {
+
+//  Barrett reduction of 64-bit values by a compile time modulus.
+template <uint32_t Modulus>
+struct Barrett {
+    static constexpr uint64_t kFactor =
+        static_cast<uint64_t>((static_cast<unsigned __int128>(1) << 64) / Modulus);
+
+    static constexpr uint32_t Reduce(uint64_t value) {
+        uint64_t quotient = (static_cast<unsigned __int128>(value) * kFactor) >> 64;
+        uint64_t remainder = value - quotient * Modulus;
+        return remainder >= Modulus ? remainder - Modulus : remainder;
+    }
+};
+
+}  // namespace detail_modular
+
+//  Element of Z / Modulus Z. The modulus is below 2^31, so a product of two residues fits in 62
+//  bits and several of them can be summed in 64 bits before reducing.
+template <uint32_t Modulus>
+class ModInt {
+public:
+    static_assert(1 < Modulus && Modulus < (1u << 31), "Modulus must be in (1, 2^31)");
+
+    static constexpr uint32_t kModulus = Modulus;
+
+    constexpr ModInt() = default;
+
+    //  Implicit, so that literals like 0 and -1 used by the engines behave as for integers.
+    constexpr ModInt(int64_t value) : value_(Normalize(value)) {
+    }
+
+    constexpr uint32_t Value() const {
+        return value_;
+    }
+
+    constexpr ModInt& operator+=(const ModInt& other) {
+        value_ += other.value_;
+        if (value_ >= Modulus) {
+            value_ -= Modulus;
+        }
+        return *this;
+    }
+
+    constexpr ModInt& operator-=(const ModInt& other) {
+        value_ = value_ >= other.value_ ? value_ - other.value_ : value_ + Modulus - other.value_;
+        return *this;
+    }
+
+    constexpr ModInt& operator*=(const ModInt& other) {
+        value_ = detail_modular::Barrett<Modulus>::Reduce(static_cast<uint64_t>(value_) *
+                                                          other.value_);
+        return *this;
+    }
+
+    constexpr ModInt operator-() const {
+        return ModInt() -= *this;
+    }
+
+private:
+    static constexpr uint32_t Normalize(int64_t value) {
+        int64_t remainder = value % static_cast<int64_t>(Modulus);
+        return static_cast<uint32_t>(remainder < 0 ? remainder + Modulus : remainder);
+    }
+
+    friend constexpr ModInt operator+(ModInt lhs, const ModInt& rhs) {
+        return lhs += rhs;
+    }
+
+    friend constexpr ModInt operator-(ModInt lhs, const ModInt& rhs) {
+        return lhs -= rhs;
+    }
+
+    friend constexpr ModInt operator*(ModInt lhs, const ModInt& rhs) {
+        return lhs *= rhs;
+    }
+
+    friend constexpr bool operator==(const ModInt& lhs, const ModInt& rhs) {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend constexpr bool operator!=(const ModInt& lhs, const ModInt& rhs) {
+        return lhs.value_ != rhs.value_;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ModInt& element) {
+        return os << element.value_;
+    }
+
+    uint32_t value_ = 0;
+};
+
+namespace detail_modular {
+
+//  How many products of residues can be added to a reduced accumulator without overflowing.
+template <uint32_t Modulus>
+constexpr uint64_t kDelayedSteps =
+    std::min<uint64_t>(1u << 20, (UINT64_MAX - (Modulus - 1)) /
+                                     (static_cast<uint64_t>(Modulus - 1) * (Modulus - 1)));
+
+}  // namespace detail_modular
+
+namespace detail_modular {
+
+//  Rows of rhs widened to 64-bit lanes, so they can be multiplied by a residue in SIMD registers.
+template <uint32_t Modulus>
+std::vector<uint64_t> Widen(const Matrix<ModInt<Modulus>>& matrix) {
+    std::vector<uint64_t> wide(matrix.Rows() * matrix.Columns());
+    for (size_t i = 0; i < wide.size(); ++i) {
+        wide[i] = matrix.Data()[i].Value();
+    }
+    return wide;
+}
+
+//  Every output row is accumulated as scaled rhs rows in 64 bits and reduced only every
+//  kDelayedSteps products.
+template <uint32_t Modulus>
+void MultiplyRows(const Matrix<ModInt<Modulus>>& lhs, const std::vector<uint64_t>& rhs_wide,
+                  int64_t row_begin, int64_t row_end, Matrix<ModInt<Modulus>>* result) {
+    using Index = typename Matrix<ModInt<Modulus>>::Index;
+    using SIMDtype = xsimd::batch<uint64_t>;
+
+    Index inner = lhs.Columns();
+    Index columns = result->Columns();
+
+    Index register_size = SIMDtype::size;
+    Index vec_size = columns - columns % register_size;
+
+    std::vector<uint64_t> accumulator(columns);
+
+    for (Index row = row_begin; row < row_end; ++row) {
+        std::fill(accumulator.begin(), accumulator.end(), 0);
+
+        for (Index block = 0; block < inner; block += kDelayedSteps<Modulus>) {
+            Index block_end = std::min<Index>(inner, block + kDelayedSteps<Modulus>);
+
+            for (Index k = block; k < block_end; ++k) {
+                uint64_t scale = lhs(row, k).Value();
+                const uint64_t* rhs_row = rhs_wide.data() + k * columns;
+                SIMDtype scale_vec(scale);
+
+                for (Index i = 0; i < vec_size; i += register_size) {
+                    SIMDtype acc = SIMDtype::load_unaligned(accumulator.data() + i);
+                    acc += scale_vec * SIMDtype::load_unaligned(rhs_row + i);
+                    acc.store_unaligned(accumulator.data() + i);
+                }
+
+                for (Index i = vec_size; i < columns; ++i) {
+                    accumulator[i] += scale * rhs_row[i];
+                }
+            }
+
+            for (Index i = 0; i < columns; ++i) {
+                accumulator[i] = Barrett<Modulus>::Reduce(accumulator[i]);
+            }
+        }
+
+        for (Index i = 0; i < columns; ++i) {
+            (*result)(row, i) = ModInt<Modulus>(accumulator[i]);
+        }
+    }
+}
+
+}  // namespace detail_modular
+
+template <uint32_t Modulus>
+void SimdMultiplication(const Matrix<ModInt<Modulus>>& lhs, const Matrix<ModInt<Modulus>>& rhs,
+                        Matrix<ModInt<Modulus>>* result, Executor* executor = nullptr) {
+    using utils::kAsyncRowBlockSize;
+
+    assert(lhs.Columns() == rhs.Rows());
+    assert(result != &lhs && result != &rhs);
+
+    std::vector<uint64_t> rhs_wide = detail_modular::Widen(rhs);
+    if (executor == nullptr) {
+        result->Reset(lhs.Rows(), rhs.Columns());
+        detail_modular::MultiplyRows(lhs, rhs_wide, 0, lhs.Rows(), result);
+        return;
+    }
+
+    result->Reset(lhs.Rows(), rhs.Columns(), *executor);
+    ParallelFor(*executor, lhs.Rows(), kAsyncRowBlockSize, [&](int64_t begin, int64_t end) {
+        detail_modular::MultiplyRows(lhs, rhs_wide, begin, end, result);
+    });
+}
+
+//  Modular engine with delayed reduction. Found by ADL from Strassen and CacheObliviousMult
+//  leaves, so both run on it for ModInt matrices.
+template <uint32_t Modulus>
+Matrix<ModInt<Modulus>> SimdMultiplication(const Matrix<ModInt<Modulus>>& lhs,
+                                           const Matrix<ModInt<Modulus>>& rhs,
+                                           Executor* executor = nullptr) {
+    assert(lhs.Columns() == rhs.Rows());
+
+    Matrix<ModInt<Modulus>> result;
+    if (executor != nullptr) {
+        SimdMultiplication(lhs, rhs, &result, executor);
+        return result;
+    }
+
+    result.Reset(lhs.Rows(), rhs.Columns(), kUninitialized);
+    detail_modular::MultiplyRows(lhs, detail_modular::Widen(rhs), 0, lhs.Rows(), &result);
+
+    return result;
+}
+
+}  // namespace s_fast
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "allocator.h"
+#include "matrix.h"
+#include "xsimd/xsimd.hpp"
+
+namespace s_fast {
+
+namespace detail_morton {
+
+using Index = typename Matrix<int>::Index;
+
+constexpr Index kTileSize = 32;
+constexpr Index kTileElements = kTileSize * kTileSize;
+
+//  Inserts a zero bit before every bit of the lower 32 bits of value.
+inline uint64_t SpreadBits(uint64_t value) {
+    value &= 0xffffffff;
+    value = (value | (value << 16)) & 0x0000ffff0000ffff;
+    value = (value | (value << 8)) & 0x00ff00ff00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0f;
+    value = (value | (value << 2)) & 0x3333333333333333;
+    value = (value | (value << 1)) & 0x5555555555555555;
+    return value;
+}
+
+//  Position of a tile in Z order: left top, right top, left bottom, right bottom quadrants.
+inline Index TileOffset(Index tile_row, Index tile_column) {
+    return static_cast<Index>((SpreadBits(tile_row) << 1) | SpreadBits(tile_column)) *
+           kTileElements;
+}
+
+inline Index TilesPerSide(Index size) {
+    Index tiles = 1;
+    while (tiles * kTileSize < size) {
+        tiles *= 2;
+    }
+    return tiles;
+}
+
+//  c += a * b for row major kTileSize x kTileSize tiles.
+template <class T>
+void MultiplyTile(const T* a, const T* b, T* c) {
+    using SIMDtype = xsimd::batch<T>;
+
+    constexpr Index kRegisterSize = SIMDtype::size;
+    static_assert(kTileSize % kRegisterSize == 0);
+
+    for (Index row = 0; row < kTileSize; ++row) {
+        T* c_row = c + row * kTileSize;
+
+        for (Index k = 0; k < kTileSize; ++k) {
+            SIMDtype scale(a[row * kTileSize + k]);
+            const T* b_row = b + k * kTileSize;
+
+            for (Index i = 0; i < kTileSize; i += kRegisterSize) {
+                SIMDtype acc = SIMDtype::load_unaligned(c_row + i);
+                acc += scale * SIMDtype::load_unaligned(b_row + i);
+                acc.store_unaligned(c_row + i);
+            }
+        }
+    }
+}
+
+}  // namespace detail_morton
+
+//  Square grid of kTileSize x kTileSize row major tiles stored in Z (Morton) order, so every
+//  quadrant on every recursion level is one contiguous range. The grid side is a power of two
+//  number of tiles; elements outside Rows() x Columns() are zero.
+template <class T>
+class MortonMatrix {
+public:
+    using Index = typename Matrix<T>::Index;
+
+    static constexpr Index kTileSize = detail_morton::kTileSize;
+
+    MortonMatrix() = default;
+
+    MortonMatrix(Index rows, Index columns, Index tiles_per_side = 0)
+        : rows_(rows),
+          columns_(columns),
+          tiles_per_side_(tiles_per_side == 0
+                              ? detail_morton::TilesPerSide(std::max(rows, columns))
+                              : tiles_per_side),
+          data_(tiles_per_side_ * tiles_per_side_ * detail_morton::kTileElements, 0) {
+        assert(tiles_per_side_ * kTileSize >= std::max(rows, columns));
+        assert((tiles_per_side_ & (tiles_per_side_ - 1)) == 0);
+    }
+
+    explicit MortonMatrix(const Matrix<T>& matrix, Index tiles_per_side = 0)
+        : MortonMatrix(matrix.Rows(), matrix.Columns(), tiles_per_side) {
+
+        for (Index row = 0; row < rows_; ++row) {
+            for (Index column = 0; column < columns_; column += kTileSize) {
+                Index length = std::min(kTileSize, columns_ - column);
+                const T* from = matrix.Data() + row * columns_ + column;
+                std::copy(from, from + length, TileRow(row, column));
+            }
+        }
+    }
+
+    Index Rows() const {
+        return rows_;
+    }
+
+    Index Columns() const {
+        return columns_;
+    }
+
+    Index TilesPerSide() const {
+        return tiles_per_side_;
+    }
+
+    void SetZero() {
+        std::fill(data_.begin(), data_.end(), 0);
+    }
+
+    T& operator()(Index row, Index column) {
+        assert(0 <= row && row < Rows() && 0 <= column && column < Columns());
+
+        return data_[Offset(row, column)];
+    }
+
+    helper::ReturnAs<T> operator()(Index row, Index column) const {
+        assert(0 <= row && row < Rows() && 0 <= column && column < Columns());
+
+        return data_[Offset(row, column)];
+    }
+
+    //  Pointer to (row, column); elements up to the end of its tile row follow contiguously.
+    T* TileRow(Index row, Index column) {
+        return data_.data() + Offset(row, column);
+    }
+
+    const T* TileRow(Index row, Index column) const {
+        return data_.data() + Offset(row, column);
+    }
+
+    T* Data() {
+        return data_.data();
+    }
+
+    const T* Data() const {
+        return data_.data();
+    }
+
+private:
+    static Index Offset(Index row, Index column) {
+        return detail_morton::TileOffset(row / kTileSize, column / kTileSize) +
+               (row % kTileSize) * kTileSize + column % kTileSize;
+    }
+
+    Index rows_ = 0;
+    Index columns_ = 0;
+    Index tiles_per_side_ = 0;
+    std::vector<T, MatrixAllocator<T>> data_;
+};
+
+template <class T>
+MortonMatrix<T> ToMorton(const Matrix<T>& matrix, typename Matrix<T>::Index tiles_per_side = 0) {
+    return MortonMatrix<T>(matrix, tiles_per_side);
+}
+
+template <class T>
+Matrix<T> ToRowMajor(const MortonMatrix<T>& matrix) {
+    using Index = typename Matrix<T>::Index;
+
+    Matrix<T> result(matrix.Rows(), matrix.Columns(), kUninitialized);
+
+    for (Index row = 0; row < matrix.Rows(); ++row) {
+        for (Index column = 0; column < matrix.Columns(); column += MortonMatrix<T>::kTileSize) {
+            Index length = std::min(MortonMatrix<T>::kTileSize, matrix.Columns() - column);
+            const T* from = matrix.TileRow(row, column);
+            std::copy(from, from + length, result.Data() + row * matrix.Columns() + column);
+        }
+    }
+
+    return result;
+}
+
+//  Number of tiles per side that fits both operands and the result of lhs * rhs.
+template <class T>
+typename Matrix<T>::Index MortonTilesPerSide(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+    return detail_morton::TilesPerSide(std::max({lhs.Rows(), lhs.Columns(), rhs.Columns()}));
+}
+
+}  // namespace s_fast
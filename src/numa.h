@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace s_fast {
+
+namespace detail_numa {
+
+//  Parses a sysfs list such as "0-3,8,10-11".
+inline std::vector<int> ParseList(const std::string& list) {
+    std::vector<int> result;
+    std::stringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+        for (int i = first; i <= last; ++i) {
+            result.push_back(i);
+        }
+    }
+
+    return result;
+}
+
+inline std::string ReadLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+//  CPUs of every online NUMA node that this process is allowed to run on. Nodes without such CPUs
+//  are dropped. Without sysfs all allowed CPUs form one node; on other systems the only node has
+//  an empty CPU list, meaning "any CPU".
+inline std::vector<std::vector<int>> NodeCpus() {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return {{}};
+    }
+
+    std::vector<std::vector<int>> nodes;
+    const std::string root = "/sys/devices/system/node/";
+
+    for (int node : ParseList(ReadLine(root + "online"))) {
+        std::vector<int> cpus;
+        for (int cpu : ParseList(ReadLine(root + "node" + std::to_string(node) + "/cpulist"))) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+
+    if (nodes.empty()) {
+        nodes.emplace_back();
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                nodes.back().push_back(cpu);
+            }
+        }
+    }
+
+    return nodes;
+#else
+    return {{}};
+#endif
+}
+
+//  Restricts the calling thread to the given CPUs. Best effort: an empty list or a failure leaves
+//  the thread where the scheduler puts it.
+inline void PinCurrentThread(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpus;
+#endif
+}
+
+}  // namespace detail_numa
+
+}  // namespace s_fast
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include "allocator.h"
+#include "epilogue.h"
+#include "executor.h"
+#include "matrix.h"
+#include "utils.h"
+#include "xsimd/xsimd.hpp"
+
+namespace s_fast {
+
+namespace detail_packed {
+
+using Index = utils::Index;
+
+constexpr Index kPanelBatches = 2;
+constexpr Index kRowBlock = 4;
+
+//  Columns per packed panel: two simd registers, so a kRowBlock x panel block of the result fits
+//  in kRowBlock * kPanelBatches accumulator registers.
+template <class T>
+constexpr Index kPanelWidth = kPanelBatches * xsimd::batch<T>::size;
+
+//  Rows result rows times one panel: result[r][0, width) = lhs row r * panel, or with Accumulate
+//  result[r][0, width) += alpha * lhs row r * panel. The panel is inner x kPanelWidth row major,
+//  so every k reads one contiguous panel row.
+template <class T, Index Rows, bool Accumulate = false>
+void MultiplyPanel(const T* lhs, Index lhs_stride, const T* panel, Index inner, T* result,
+                   Index result_stride, Index width, T alpha = T{1}) {
+    using SIMDtype = xsimd::batch<T>;
+
+    constexpr Index kRegisterSize = SIMDtype::size;
+
+    SIMDtype acc[Rows][kPanelBatches];
+    for (Index row = 0; row < Rows; ++row) {
+        for (Index batch = 0; batch < kPanelBatches; ++batch) {
+            acc[row][batch] = SIMDtype(T{0});
+        }
+    }
+
+    for (Index k = 0; k < inner; ++k) {
+        const T* panel_row = panel + k * kPanelWidth<T>;
+
+        SIMDtype rhs[kPanelBatches];
+        for (Index batch = 0; batch < kPanelBatches; ++batch) {
+            rhs[batch] = SIMDtype::load_unaligned(panel_row + batch * kRegisterSize);
+        }
+
+        for (Index row = 0; row < Rows; ++row) {
+            SIMDtype scale(lhs[row * lhs_stride + k]);
+            for (Index batch = 0; batch < kPanelBatches; ++batch) {
+                acc[row][batch] += scale * rhs[batch];
+            }
+        }
+    }
+
+    for (Index row = 0; row < Rows; ++row) {
+        T* result_row = result + row * result_stride;
+
+        if (width == kPanelWidth<T>) {
+            for (Index batch = 0; batch < kPanelBatches; ++batch) {
+                T* to = result_row + batch * kRegisterSize;
+                if constexpr (Accumulate) {
+                    acc[row][batch] =
+                        SIMDtype::load_unaligned(to) + SIMDtype(alpha) * acc[row][batch];
+                }
+                acc[row][batch].store_unaligned(to);
+            }
+            continue;
+        }
+
+        T buffer[kPanelWidth<T>];
+        for (Index batch = 0; batch < kPanelBatches; ++batch) {
+            acc[row][batch].store_unaligned(buffer + batch * kRegisterSize);
+        }
+        if constexpr (Accumulate) {
+            for (Index column = 0; column < width; ++column) {
+                result_row[column] += alpha * buffer[column];
+            }
+        } else {
+            std::copy(buffer, buffer + width, result_row);
+        }
+    }
+}
+
+}  // namespace detail_packed
+
+//  Right hand operand repacked once into column panels of kPanelWidth columns, each stored row
+//  major and zero padded, which is the layout the packed kernel streams. Immutable after
+//  construction, so one PackedMatrix can be shared by any number of concurrent multiplications.
+template <class T>
+class PackedMatrix {
+public:
+    using Index = typename Matrix<T>::Index;
+
+    static_assert(std::is_arithmetic_v<T>, "Packed panels are multiplied with simd registers");
+
+    static constexpr Index kPanelWidth = detail_packed::kPanelWidth<T>;
+
+    explicit PackedMatrix(const Matrix<T>& matrix)
+        : PackedMatrix(matrix.Data(), matrix.Columns(), matrix.Rows(), matrix.Columns()) {
+    }
+
+    //  Packs a rows x columns block of a row major matrix whose rows are stride elements apart.
+    PackedMatrix(const T* data, Index stride, Index rows, Index columns)
+        : rows_(rows), columns_(columns), data_(Panels() * rows_ * kPanelWidth, 0) {
+
+        for (Index panel = 0; panel < Panels(); ++panel) {
+            Index first = panel * kPanelWidth;
+            Index width = std::min(kPanelWidth, columns_ - first);
+
+            for (Index row = 0; row < rows_; ++row) {
+                const T* from = data + row * stride + first;
+                std::copy(from, from + width, data_.data() + Offset(panel) + row * kPanelWidth);
+            }
+        }
+    }
+
+    Index Rows() const {
+        return rows_;
+    }
+
+    Index Columns() const {
+        return columns_;
+    }
+
+    Index Panels() const {
+        return (columns_ + kPanelWidth - 1) / kPanelWidth;
+    }
+
+    const T* Panel(Index panel) const {
+        return data_.data() + Offset(panel);
+    }
+
+private:
+    Index Offset(Index panel) const {
+        return panel * rows_ * kPanelWidth;
+    }
+
+    Index rows_;
+    Index columns_;
+    std::vector<T, MatrixAllocator<T>> data_;
+};
+
+namespace detail_packed {
+
+//  Computes rows [row_begin, row_end) of lhs * rhs, overwriting them. lhs and result are row
+//  major with the given strides. Every block of kRowBlock finished rows, written panel by panel
+//  and still in cache, is passed to the epilogue row by row.
+template <class T, class Op>
+void MultiplyRows(const T* lhs, Index lhs_stride, const PackedMatrix<T>& rhs, Index row_begin,
+                  Index row_end, T* result, Index result_stride, const Epilogue<Op>& epilogue) {
+    Index inner = rhs.Rows();
+    Index columns = rhs.Columns();
+
+    for (Index row = row_begin; row < row_end;) {
+        bool full = row + kRowBlock <= row_end;
+
+        for (Index panel = 0; panel < rhs.Panels(); ++panel) {
+            Index first = panel * kPanelWidth<T>;
+            Index width = std::min(kPanelWidth<T>, columns - first);
+            const T* lhs_rows = lhs + row * lhs_stride;
+            T* result_rows = result + row * result_stride + first;
+
+            if (full) {
+                MultiplyPanel<T, kRowBlock>(lhs_rows, lhs_stride, rhs.Panel(panel), inner,
+                                            result_rows, result_stride, width);
+            } else {
+                MultiplyPanel<T, 1>(lhs_rows, lhs_stride, rhs.Panel(panel), inner, result_rows,
+                                    result_stride, width);
+            }
+        }
+
+        Index rows = full ? kRowBlock : 1;
+        for (Index block_row = row; block_row < row + rows; ++block_row) {
+            epilogue(result + block_row * result_stride, block_row, 0, columns);
+        }
+
+        row += rows;
+    }
+}
+
+template <class T>
+void MultiplyRows(const T* lhs, Index lhs_stride, const PackedMatrix<T>& rhs, Index row_begin,
+                  Index row_end, T* result, Index result_stride) {
+    MultiplyRows(lhs, lhs_stride, rhs, row_begin, row_end, result, result_stride, NoEpilogue());
+}
+
+template <class T>
+void MultiplyRows(const Matrix<T>& lhs, const PackedMatrix<T>& rhs, Index row_begin,
+                  Index row_end, Matrix<T>* result) {
+    MultiplyRows(lhs.Data(), lhs.Columns(), rhs, row_begin, row_end, result->Data(),
+                 result->Columns());
+}
+
+//  Rows [row_begin, row_end) of result += alpha * lhs * rhs, accumulated straight into result
+//  without a product buffer. Same layouts as MultiplyRows.
+template <class T>
+void AccumulateRows(const T* lhs, Index lhs_stride, const PackedMatrix<T>& rhs, T alpha,
+                    Index row_begin, Index row_end, T* result, Index result_stride) {
+    Index inner = rhs.Rows();
+    Index columns = rhs.Columns();
+
+    for (Index row = row_begin; row < row_end;) {
+        bool full = row + kRowBlock <= row_end;
+
+        for (Index panel = 0; panel < rhs.Panels(); ++panel) {
+            Index first = panel * kPanelWidth<T>;
+            Index width = std::min(kPanelWidth<T>, columns - first);
+            const T* lhs_rows = lhs + row * lhs_stride;
+            T* result_rows = result + row * result_stride + first;
+
+            if (full) {
+                MultiplyPanel<T, kRowBlock, true>(lhs_rows, lhs_stride, rhs.Panel(panel), inner,
+                                                  result_rows, result_stride, width, alpha);
+            } else {
+                MultiplyPanel<T, 1, true>(lhs_rows, lhs_stride, rhs.Panel(panel), inner,
+                                          result_rows, result_stride, width, alpha);
+            }
+        }
+
+        row += full ? kRowBlock : 1;
+    }
+}
+
+}  // namespace detail_packed
+
+//  Writes lhs * rhs into an existing matrix, reusing its storage. With an executor the rows are
+//  split between its threads. result must not alias lhs.
+template <class T>
+void SimdMultiplication(const Matrix<T>& lhs, const PackedMatrix<T>& rhs, Matrix<T>* result,
+                        Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
+    assert(lhs.Columns() == rhs.Rows());
+    assert(result != &lhs);
+
+    result->Reset(lhs.Rows(), rhs.Columns(), kUninitialized);
+
+    if (executor == nullptr) {
+        detail_packed::MultiplyRows(lhs, rhs, 0, lhs.Rows(), result);
+        return;
+    }
+
+    ParallelFor(*executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_packed::MultiplyRows(lhs, rhs, begin, end, result);
+    });
+}
+
+//  lhs * rhs with a prepacked rhs: no transpose or copy of rhs per call.
+template <class T>
+Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const PackedMatrix<T>& rhs,
+                             Executor* executor = nullptr) {
+    Matrix<T> result;
+    SimdMultiplication(lhs, rhs, &result, executor);
+
+    return result;
+}
+
+//  lhs * rhs with the epilogue fused into the packed kernel: it is applied to every tile as soon
+//  as the tile is stored, so e.g. bias, scale and activation cost no extra pass over the result.
+template <class T, class Op>
+Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const PackedMatrix<T>& rhs,
+                             const Epilogue<Op>& epilogue, Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
+    assert(lhs.Columns() == rhs.Rows());
+
+    Matrix<T> result(lhs.Rows(), rhs.Columns(), kUninitialized);
+
+    ParallelFor(executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_packed::MultiplyRows(lhs.Data(), lhs.Columns(), rhs, begin, end, result.Data(),
+                                    result.Columns(), epilogue);
+    });
+
+    return result;
+}
+
+}  // namespace s_fast
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "executor.h"
+#include "matrix.h"
+#include "morton_matrix.h"
+#include "simd_multiplication.h"
+#include "strassen.h"
+#include "utils.h"
+
+namespace s_fast {
+
+namespace detail_power {
+
+template <class T>
+Matrix<T> Identity(typename Matrix<T>::Index size) {
+    Matrix<T> identity(size, size);
+    for (typename Matrix<T>::Index i = 0; i < size; ++i) {
+        identity(i, i) = 1;
+    }
+    return identity;
+}
+
+//  Binary exponentiation over three buffers: the running square, the accumulated result and a
+//  scratch buffer every product is written into before being swapped in. multiply(lhs, rhs, out)
+//  must overwrite *out reusing its storage. exponent must be positive.
+template <class Buffer, class Multiply>
+Buffer PowerBySquaring(Buffer base, uint64_t exponent, Multiply multiply) {
+    assert(exponent > 0);
+
+    Buffer result;
+    Buffer scratch;
+    bool has_result = false;
+
+    while (true) {
+        if (exponent & 1) {
+            if (has_result) {
+                multiply(result, base, &scratch);
+                std::swap(result, scratch);
+            } else {
+                result = base;
+                has_result = true;
+            }
+        }
+
+        exponent >>= 1;
+        if (exponent == 0) {
+            return result;
+        }
+
+        multiply(base, base, &scratch);
+        std::swap(base, scratch);
+    }
+}
+
+template <class T>
+void MultiplyMorton(const MortonMatrix<T>& lhs, const MortonMatrix<T>& rhs,
+                    MortonMatrix<T>* result) {
+    if (result->TilesPerSide() != lhs.TilesPerSide()) {
+        *result = MortonMatrix<T>(lhs.Rows(), rhs.Columns(), lhs.TilesPerSide());
+    } else {
+        result->SetZero();
+    }
+
+    detail_strassen::Strassen(lhs.Data(), rhs.Data(), result->Data(), lhs.TilesPerSide());
+}
+
+}  // namespace detail_power
+
+//  matrix^exponent by repeated squaring. Large floating point and integer matrices are squared
+//  with Strassen on the Morton layout, everything else (including ModInt) with the simd engine.
+template <class T>
+Matrix<T> Power(const Matrix<T>& matrix, uint64_t exponent) {
+    using utils::kPowerMortonConstant;
+
+    assert(matrix.Rows() == matrix.Columns());
+
+    if (exponent == 0) {
+        return detail_power::Identity<T>(matrix.Rows());
+    }
+
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (matrix.Rows() >= kPowerMortonConstant) {
+            return ToRowMajor(detail_power::PowerBySquaring(
+                ToMorton(matrix), exponent, detail_power::MultiplyMorton<T>));
+        }
+    }
+
+    return detail_power::PowerBySquaring(
+        matrix, exponent, [](const Matrix<T>& lhs, const Matrix<T>& rhs, Matrix<T>* result) {
+            SimdMultiplication(lhs, rhs, result);
+        });
+}
+
+//  Parallel version: every product splits its rows between the executor's threads.
+template <class T>
+Matrix<T> Power(const Matrix<T>& matrix, uint64_t exponent, Executor& executor) {
+    assert(matrix.Rows() == matrix.Columns());
+
+    if (exponent == 0) {
+        return detail_power::Identity<T>(matrix.Rows());
+    }
+
+    return detail_power::PowerBySquaring(
+        matrix, exponent,
+        [&executor](const Matrix<T>& lhs, const Matrix<T>& rhs, Matrix<T>* result) {
+            SimdMultiplication(lhs, rhs, result, &executor);
+        });
+}
+
+}  // namespace s_fast
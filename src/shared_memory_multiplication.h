@@ -0,0 +1,209 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "matrix.h"
+#include "simd_multiplication.h"
+#include "utils.h"
+
+namespace s_fast {
+
+namespace detail_shared_memory {
+
+using Index = utils::Index;
+
+constexpr size_t kAlignment = 64;
+
+inline size_t AlignUp(size_t size) {
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+//  Coordination block at the start of the segment. Workers claim output tiles with fetch_add on
+//  next_tile; completed is only read by the coordinator after every worker exited.
+struct Header {
+    std::atomic<int64_t> next_tile;
+    std::atomic<int64_t> completed;
+    Index rows;
+    Index inner;
+    Index columns;
+    Index tile_size;
+};
+
+static_assert(std::atomic<int64_t>::is_always_lock_free,
+              "Atomics in shared memory must not depend on a process local lock");
+
+//  POSIX shared memory segment, unlinked and unmapped on destruction.
+class Segment {
+public:
+    explicit Segment(size_t size) : size_(size) {
+        static std::atomic<uint64_t> counter = 0;
+        name_ = "/s_fast_" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+
+        int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name_);
+        }
+
+        if (ftruncate(fd, size_) == -1) {
+            int error = errno;
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate " + name_);
+        }
+
+        data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd);
+
+        if (data_ == MAP_FAILED) {
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "mmap " + name_);
+        }
+    }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    ~Segment() {
+        munmap(data_, size_);
+        shm_unlink(name_.c_str());
+    }
+
+    char* Data() const {
+        return static_cast<char*>(data_);
+    }
+
+    const std::string& Name() const {
+        return name_;
+    }
+
+private:
+    std::string name_;
+    size_t size_;
+    void* data_ = nullptr;
+};
+
+//  Claims output tiles until none are left. For every tile the inner dimension is walked in
+//  panels of tile_size, SUMMA style, so the touched panel of b stays in cache. Does not allocate,
+//  as it runs in a forked child.
+template <class T>
+void Work(Header* header, const T* a, const T* b, T* c) {
+    Index tile = header->tile_size;
+    Index tile_rows = (header->rows + tile - 1) / tile;
+    Index tile_columns = (header->columns + tile - 1) / tile;
+
+    for (Index task = header->next_tile.fetch_add(1); task < tile_rows * tile_columns;
+         task = header->next_tile.fetch_add(1)) {
+        Index row_begin = task / tile_columns * tile;
+        Index row_end = std::min(header->rows, row_begin + tile);
+        Index column_begin = task % tile_columns * tile;
+        Index column_end = std::min(header->columns, column_begin + tile);
+
+        for (Index panel = 0; panel < header->inner; panel += tile) {
+            Index panel_end = std::min(header->inner, panel + tile);
+
+            for (Index row = row_begin; row < row_end; ++row) {
+                for (Index k = panel; k < panel_end; ++k) {
+                    detail_simd::Axpy(a[row * header->inner + k],
+                                      b + k * header->columns + column_begin,
+                                      c + row * header->columns + column_begin,
+                                      column_end - column_begin);
+                }
+            }
+        }
+
+        header->completed.fetch_add(1);
+    }
+}
+
+}  // namespace detail_shared_memory
+
+//  Splits lhs * rhs into 2D output tiles computed by `processes` forked worker processes. The
+//  operands and the result live in one POSIX shared memory segment; the calling process only
+//  coordinates. Throws std::system_error if the segment or the workers cannot be created, and
+//  std::runtime_error if a worker dies before its tiles are done.
+template <class T>
+Matrix<T> SharedMemoryMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs, int processes,
+                                     utils::Index tile_size = utils::kSharedMemoryTileSize) {
+    using detail_shared_memory::AlignUp;
+    using detail_shared_memory::Header;
+
+    static_assert(std::is_trivially_copyable_v<T>, "Elements are copied into shared memory");
+
+    assert(lhs.Columns() == rhs.Rows());
+    assert(processes > 0 && tile_size > 0);
+
+    size_t lhs_bytes = AlignUp(sizeof(T) * lhs.Rows() * lhs.Columns());
+    size_t rhs_bytes = AlignUp(sizeof(T) * rhs.Rows() * rhs.Columns());
+    size_t result_bytes = AlignUp(sizeof(T) * lhs.Rows() * rhs.Columns());
+    size_t header_bytes = AlignUp(sizeof(Header));
+
+    detail_shared_memory::Segment segment(header_bytes + lhs_bytes + rhs_bytes + result_bytes);
+
+    //  A fresh segment is zero filled, so the result needs no initialization.
+    auto* header = new (segment.Data())
+        Header{0, 0, lhs.Rows(), lhs.Columns(), rhs.Columns(), tile_size};
+    auto* a = reinterpret_cast<T*>(segment.Data() + header_bytes);
+    auto* b = reinterpret_cast<T*>(segment.Data() + header_bytes + lhs_bytes);
+    auto* c = reinterpret_cast<T*>(segment.Data() + header_bytes + lhs_bytes + rhs_bytes);
+
+    std::copy(lhs.Data(), lhs.Data() + lhs.Rows() * lhs.Columns(), a);
+    std::copy(rhs.Data(), rhs.Data() + rhs.Rows() * rhs.Columns(), b);
+
+    std::vector<pid_t> workers;
+    int fork_error = 0;
+
+    for (int i = 0; i < processes; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            detail_shared_memory::Work(header, a, b, c);
+            _exit(0);
+        }
+        if (pid == -1) {
+            fork_error = errno;
+            break;
+        }
+        workers.push_back(pid);
+    }
+
+    bool failed = false;
+    for (pid_t worker : workers) {
+        int status = 0;
+        while (waitpid(worker, &status, 0) == -1 && errno == EINTR) {
+        }
+        failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+
+    if (workers.empty()) {
+        throw std::system_error(fork_error, std::generic_category(), "fork");
+    }
+
+    utils::Index tiles = ((lhs.Rows() + tile_size - 1) / tile_size) *
+                         ((rhs.Columns() + tile_size - 1) / tile_size);
+    if (failed || header->completed.load() != tiles) {
+        throw std::runtime_error("Shared memory worker failed in " + segment.Name());
+    }
+
+    Matrix<T> result(lhs.Rows(), rhs.Columns(), kUninitialized);
+    std::copy(c, c + lhs.Rows() * rhs.Columns(), result.Data());
+
+    return result;
+}
+
+}  // namespace s_fast
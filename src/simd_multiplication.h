@@ -1,41 +1,230 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include "epilogue.h"
+#include "executor.h"
 #include "matrix.h"
+#include "utils.h"
+#include "view_matrix.h"
 #include "xsimd/xsimd.hpp"
 
 namespace s_fast {
 
+namespace detail_simd {
+
+using Index = typename Matrix<int>::Index;
+
+constexpr Index kTransposedLhsRowBlock = 32;
+
 template <class T>
-Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs) {
-    using Index = typename Matrix<T>::Index;
+T Dot(const T* lhs, const T* rhs, Index size) {
     using SIMDtype = xsimd::batch<T>;
 
+    Index register_size = SIMDtype::size;
+    Index vec_size = size - size % register_size;
+
+    SIMDtype acc(T{0});
+    for (Index i = 0; i < vec_size; i += register_size) {
+        acc += SIMDtype::load_unaligned(lhs + i) * SIMDtype::load_unaligned(rhs + i);
+    }
+
+    T result = xsimd::reduce_add(acc);
+    for (Index i = vec_size; i < size; ++i) {
+        result += lhs[i] * rhs[i];
+    }
+
+    return result;
+}
+
+//  result += scale * from for `size` contiguous elements.
+template <class T>
+void Axpy(T scale, const T* from, T* result, Index size) {
+    using SIMDtype = xsimd::batch<T>;
+
+    Index register_size = SIMDtype::size;
+    Index vec_size = size - size % register_size;
+
+    SIMDtype scale_vec(scale);
+    for (Index i = 0; i < vec_size; i += register_size) {
+        SIMDtype acc = SIMDtype::load_unaligned(result + i);
+        acc += scale_vec * SIMDtype::load_unaligned(from + i);
+        acc.store_unaligned(result + i);
+    }
+
+    for (Index i = vec_size; i < size; ++i) {
+        result[i] += scale * from[i];
+    }
+}
+
+//  result(row, column) = <lhs row, rhs_t row> for rows [row_begin, row_end). Both operands are
+//  row major with the given strides and `inner` elements per dot product.
+template <class T>
+void DotRows(const T* lhs, Index lhs_stride, const T* rhs_t, Index rhs_t_stride, Index inner,
+             Index row_begin, Index row_end, Matrix<T>* result) {
+    for (Index row = row_begin; row < row_end; ++row) {
+        const T* lhs_row = lhs + row * lhs_stride;
+
+        for (Index column = 0; column < result->Columns(); ++column) {
+            (*result)(row, column) = Dot(lhs_row, rhs_t + column * rhs_t_stride, inner);
+        }
+    }
+}
+
+//  Computes rows [row_begin, row_end) of lhs * rhs, where rhs_t is the already transposed rhs.
+template <class T>
+void MultiplyRows(const Matrix<T>& lhs, const Matrix<T>& rhs_t, Index row_begin, Index row_end,
+                  Matrix<T>* result) {
+    assert(lhs.Columns() == rhs_t.Columns());
+    assert(result->Rows() == lhs.Rows() && result->Columns() == rhs_t.Rows());
+
+    DotRows(lhs.Data(), lhs.Columns(), rhs_t.Data(), rhs_t.Columns(), lhs.Columns(), row_begin,
+            row_end, result);
+}
+
+//  Result rows [row_begin, row_end) += lhs_t^T * rhs as a sum of scaled rhs rows, so neither
+//  operand is transposed. Result rows are processed in blocks to keep them in cache while lhs_t is
+//  streamed.
+template <class T>
+void AxpyRows(const ConstViewMatrix<T>& lhs_t, const Matrix<T>& rhs, Index row_begin,
+              Index row_end, Matrix<T>* result) {
+    Index columns = rhs.Columns();
+
+    for (Index block = row_begin; block < row_end; block += kTransposedLhsRowBlock) {
+        Index block_end = std::min(row_end, block + kTransposedLhsRowBlock);
+
+        for (Index k = 0; k < rhs.Rows(); ++k) {
+            const T* lhs_row = lhs_t.Data() + k * lhs_t.Stride();
+            const T* rhs_row = rhs.Data() + k * columns;
+
+            for (Index row = block; row < block_end; ++row) {
+                Axpy(lhs_row[row], rhs_row, result->Data() + row * columns, columns);
+            }
+        }
+    }
+}
+
+//  result rows [row_begin, row_end) += lhs rows * rhs, accumulated as scaled rhs rows, so rhs is
+//  read with unit stride and never transposed.
+template <class T>
+void AxpyRows(const Matrix<T>& lhs, const Matrix<T>& rhs, Index row_begin, Index row_end,
+              Matrix<T>* result) {
+    Index columns = rhs.Columns();
+
+    for (Index row = row_begin; row < row_end; ++row) {
+        T* result_row = result->Data() + row * columns;
+
+        for (Index k = 0; k < rhs.Rows(); ++k) {
+            Axpy(lhs(row, k), rhs.Data() + k * columns, result_row, columns);
+        }
+    }
+}
+
+template <class T>
+bool IsContiguous(const ConstViewMatrix<T>& view) {
+    return view.ExistedRows() == view.Rows() && view.ExistedColumns() == view.Columns();
+}
+
+}  // namespace detail_simd
+
+//  lhs * rhs where rhs is given as a transposed view, e.g. SimdMultiplication(x, TransposedView(x))
+//  computes x * x^T without materializing the transpose. With an executor the rows of the result
+//  are split between its threads, as in every entry point below that takes one.
+template <class T>
+Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const ConstTransposedViewMatrix<T>& rhs,
+                             Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
+    const ConstViewMatrix<T>& rhs_t = rhs.Base();
+
     assert(lhs.Columns() == rhs.Rows());
+    assert(detail_simd::IsContiguous(rhs_t));
+
+    Matrix<T> result(lhs.Rows(), rhs.Columns(), kUninitialized);
+
+    ParallelFor(executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_simd::DotRows(lhs.Data(), lhs.Columns(), rhs_t.Data(), rhs_t.Stride(),
+                             lhs.Columns(), begin, end, &result);
+    });
+
+    return result;
+}
+
+//  lhs^T * rhs where lhs is given as a transposed view.
+template <class T>
+Matrix<T> SimdMultiplication(const ConstTransposedViewMatrix<T>& lhs, const Matrix<T>& rhs,
+                             Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
+    assert(lhs.Columns() == rhs.Rows());
+    assert(detail_simd::IsContiguous(lhs.Base()));
 
     Matrix<T> result(lhs.Rows(), rhs.Columns());
+
+    ParallelFor(executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_simd::AxpyRows(lhs.Base(), rhs, begin, end, &result);
+    });
+
+    return result;
+}
+
+template <class T>
+Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                             Executor* executor = nullptr) {
+    assert(lhs.Columns() == rhs.Rows());
+
     Matrix<T> rhs_t = Transpose(rhs);
 
-    for (Index row = 0; row < lhs.Rows(); ++row) {
-        for (Index column = 0; column < rhs.Columns(); ++column) {
-            Index register_size = SIMDtype::size;
-            Index vec_size = lhs.Columns() - lhs.Columns() % register_size;
+    return SimdMultiplication(lhs, TransposedView(rhs_t), executor);
+}
 
-            for (Index i = 0; i < vec_size; i += register_size) {
-                SIMDtype lhs_vec = SIMDtype::load_unaligned(&lhs.data_[row * lhs.Columns() + i]);
-                SIMDtype rhs_vec =
-                    SIMDtype::load_unaligned(&rhs_t.data_[column * rhs_t.Columns() + i]);
+//  lhs * rhs with the epilogue fused in: every result row gets it right after its dot products.
+template <class T, class Op>
+Matrix<T> SimdMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                             const Epilogue<Op>& epilogue, Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
 
-                result(row, column) += xsimd::reduce_add(lhs_vec * rhs_vec);
-            }
+    assert(lhs.Columns() == rhs.Rows());
 
-            for (Index i = vec_size; i < lhs.Columns(); ++i) {
-                result(row, column) += lhs(row, i) * rhs_t(column, i);
-            }
+    Matrix<T> rhs_t = Transpose(rhs);
+    Matrix<T> result(lhs.Rows(), rhs.Columns(), kUninitialized);
+
+    ParallelFor(executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        for (Index row = begin; row < end; ++row) {
+            detail_simd::DotRows(lhs.Data(), lhs.Columns(), rhs_t.Data(), rhs_t.Columns(),
+                                 lhs.Columns(), row, row + 1, &result);
+            epilogue(result.Data() + row * result.Columns(), row, 0, result.Columns());
         }
-    }
+    });
 
     return result;
 }
 
+//  Writes lhs * rhs into an existing matrix, reusing its storage. With an executor the rows are
+//  split between its threads, which also zero the result first so its pages land on their NUMA
+//  nodes. result must not alias lhs or rhs.
+template <class T>
+void SimdMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs, Matrix<T>* result,
+                        Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
+    assert(lhs.Columns() == rhs.Rows());
+    assert(result != &lhs && result != &rhs);
+
+    if (executor == nullptr) {
+        result->Reset(lhs.Rows(), rhs.Columns());
+        detail_simd::AxpyRows(lhs, rhs, 0, lhs.Rows(), result);
+        return;
+    }
+
+    result->Reset(lhs.Rows(), rhs.Columns(), *executor);
+    ParallelFor(*executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_simd::AxpyRows(lhs, rhs, begin, end, result);
+    });
+}
+
 }  // namespace s_fast
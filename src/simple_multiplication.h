@@ -1,43 +1,67 @@
 #pragma once
 
 #include <cstddef>
+#include "executor.h"
 #include "matrix.h"
+#include "utils.h"
+#include "view_matrix.h"
 
 namespace s_fast {
 
 template <class T>
-Matrix<T> SimpleMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+Matrix<T> SimpleMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                               Executor* executor = nullptr) {
     using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
     Matrix<T> result(lhs.Rows(), rhs.Columns());
 
-    for (Index row = 0; row < lhs.Rows(); ++row) {
-        for (Index column = 0; column < rhs.Columns(); ++column) {
-            for (Index i = 0; i < lhs.Columns(); ++i) {
-                result(row, column) += lhs(row, i) * rhs(i, column);
+    ParallelFor(executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index row_begin, Index row_end) {
+        for (Index row = row_begin; row < row_end; ++row) {
+            for (Index column = 0; column < rhs.Columns(); ++column) {
+                for (Index i = 0; i < lhs.Columns(); ++i) {
+                    result(row, column) += lhs(row, i) * rhs(i, column);
+                }
             }
         }
-    }
+    });
 
     return result;
 }
 
 template <class T>
-Matrix<T> SimpleMultiplicationWithTranspose(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+Matrix<T> SimpleMultiplicationWithTranspose(const Matrix<T>& lhs,
+                                            const ConstTransposedViewMatrix<T>& rhs,
+                                            Executor* executor = nullptr) {
     using Index = typename Matrix<T>::Index;
+    using utils::kAsyncRowBlockSize;
+
     assert(lhs.Columns() == rhs.Rows());
 
     Matrix<T> result(lhs.Rows(), rhs.Columns());
-    Matrix<T> rhs_t = Transpose(rhs);
+    const ConstViewMatrix<T>& rhs_t = rhs.Base();
 
-    for (Index row = 0; row < lhs.Rows(); ++row) {
-        for (Index column = 0; column < rhs.Columns(); ++column) {
-            for (Index i = 0; i < lhs.Columns(); ++i) {
-                result(row, column) += lhs(row, i) * rhs_t(column, i);
+    ParallelFor(executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index row_begin, Index row_end) {
+        for (Index row = row_begin; row < row_end; ++row) {
+            for (Index column = 0; column < rhs.Columns(); ++column) {
+                for (Index i = 0; i < lhs.Columns(); ++i) {
+                    result(row, column) += lhs(row, i) * rhs_t(column, i);
+                }
             }
         }
-    }
+    });
 
     return result;
 }
 
+template <class T>
+Matrix<T> SimpleMultiplicationWithTranspose(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                                            Executor* executor = nullptr) {
+    assert(lhs.Columns() == rhs.Rows());
+
+    Matrix<T> rhs_t = Transpose(rhs);
+
+    return SimpleMultiplicationWithTranspose(lhs, TransposedView(rhs_t), executor);
+}
+
 }  // namespace s_fast
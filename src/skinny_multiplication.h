@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "simd_multiplication.h"
+#include "utils.h"
+#include "view_matrix.h"
+
+namespace s_fast {
+
+namespace detail_skinny {
+
+using Index = utils::Index;
+
+//  Rows of the inner dimension a split-K chunk accumulates at a time: the slab of rhs they cover
+//  stays in cache while it is applied to every lhs row.
+constexpr Index kInnerBlock = 256;
+
+//  rows x inner times inner x columns with inner and columns small and rows much larger: rhs fits
+//  in cache and the product is a stream over lhs rows.
+inline bool IsTallSkinny(Index rows, Index inner, Index columns) {
+    using utils::kSkinnyConstant;
+    using utils::kSkinnyRatio;
+
+    return inner <= kSkinnyConstant && columns <= kSkinnyConstant &&
+           rows >= kSkinnyRatio * std::max(inner, columns);
+}
+
+//  rows and columns small, inner much larger: almost all of the work is in the inner products.
+inline bool IsInnerHeavy(Index rows, Index inner, Index columns) {
+    using utils::kSkinnyConstant;
+    using utils::kSkinnyRatio;
+
+    return rows <= kSkinnyConstant && columns <= kSkinnyConstant &&
+           inner >= kSkinnyRatio * std::max(rows, columns);
+}
+
+//  The first `rows` rows of lhs times a packed rhs, streamed through the packed kernel.
+template <class T>
+void TallSkinny(const T* lhs, Index lhs_stride, const PackedMatrix<T>& rhs, Index rows,
+                T* result, Index result_stride, Executor* executor) {
+    using utils::kAsyncRowBlockSize;
+
+    if (executor == nullptr) {
+        detail_packed::MultiplyRows(lhs, lhs_stride, rhs, 0, rows, result, result_stride);
+        return;
+    }
+
+    ParallelFor(*executor, rows, kAsyncRowBlockSize, [&](Index begin, Index end) {
+        detail_packed::MultiplyRows(lhs, lhs_stride, rhs, begin, end, result, result_stride);
+    });
+}
+
+//  partial += lhs[:, begin:end) * rhs[begin:end, :], slab by slab, as scaled rhs rows.
+template <class T>
+void AccumulateInner(const T* lhs, Index lhs_stride, const T* rhs, Index rhs_stride, Index rows,
+                     Index columns, Index begin, Index end, Matrix<T>* partial) {
+    for (Index block = begin; block < end; block += kInnerBlock) {
+        Index block_end = std::min(end, block + kInnerBlock);
+
+        for (Index row = 0; row < rows; ++row) {
+            const T* lhs_row = lhs + row * lhs_stride;
+            T* partial_row = partial->Data() + row * columns;
+
+            for (Index k = block; k < block_end; ++k) {
+                detail_simd::Axpy(lhs_row[k], rhs + k * rhs_stride, partial_row, columns);
+            }
+        }
+    }
+}
+
+//  Split-K: the inner dimension is cut into one chunk per thread, every chunk is multiplied into
+//  its own rows x columns partial product and the partials are summed in chunk order, so the
+//  result does not depend on scheduling.
+template <class T>
+void SplitK(const T* lhs, Index lhs_stride, const T* rhs, Index rhs_stride, Index rows,
+            Index inner, Index columns, T* result, Index result_stride, Executor* executor) {
+    Index parts = executor == nullptr ? 1 : static_cast<Index>(executor->Concurrency());
+    Index chunk = (inner + parts - 1) / parts;
+    chunk = std::max(kInnerBlock, (chunk + kInnerBlock - 1) / kInnerBlock * kInnerBlock);
+
+    std::vector<Matrix<T>> partials((inner + chunk - 1) / chunk);
+    auto multiply = [&](Index begin, Index end) {
+        Matrix<T>& partial = partials[begin / chunk];
+        partial.Reset(rows, columns);
+        AccumulateInner(lhs, lhs_stride, rhs, rhs_stride, rows, columns, begin, end, &partial);
+    };
+
+    if (executor == nullptr) {
+        multiply(0, inner);
+    } else {
+        ParallelFor(*executor, inner, chunk, multiply);
+    }
+
+    for (Index row = 0; row < rows; ++row) {
+        T* result_row = result + row * result_stride;
+        std::fill(result_row, result_row + columns, T{0});
+
+        for (const auto& partial : partials) {
+            detail_simd::Axpy(T{1}, partial.Data() + row * columns, result_row, columns);
+        }
+    }
+}
+
+template <class T>
+Index ExistedRows(const ConstViewMatrix<T>& view) {
+    return std::max(Index{0}, view.ExistedRows());
+}
+
+template <class T>
+Index ExistedColumns(const ConstViewMatrix<T>& view) {
+    return std::max(Index{0}, view.ExistedColumns());
+}
+
+//  lhs * rhs for views of tall-skinny or inner-heavy shape, read in place. Parts of the views
+//  beyond their matrices are zero, so only the existing parts are multiplied.
+template <class T>
+Matrix<T> Multiply(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs,
+                   Executor* executor = nullptr) {
+    assert(lhs.Columns() == rhs.Rows());
+
+    Index rows = ExistedRows(lhs);
+    Index inner = std::min(ExistedColumns(lhs), ExistedRows(rhs));
+    Index columns = ExistedColumns(rhs);
+
+    Matrix<T> result(lhs.Rows(), rhs.Columns());
+    if (rows == 0 || inner == 0 || columns == 0) {
+        return result;
+    }
+
+    if (IsInnerHeavy(lhs.Rows(), lhs.Columns(), rhs.Columns())) {
+        SplitK(lhs.Data(), lhs.Stride(), rhs.Data(), rhs.Stride(), rows, inner, columns,
+               result.Data(), result.Columns(), executor);
+        return result;
+    }
+
+    Matrix<T> small_rhs(inner, columns, kUninitialized);
+    for (Index row = 0; row < inner; ++row) {
+        std::copy(rhs.Data() + row * rhs.Stride(), rhs.Data() + row * rhs.Stride() + columns,
+                  small_rhs.Data() + row * columns);
+    }
+
+    TallSkinny(lhs.Data(), lhs.Stride(), PackedMatrix<T>(small_rhs), rows, result.Data(),
+               result.Columns(), executor);
+    return result;
+}
+
+//  The kernels work on simd registers.
+template <class T>
+constexpr bool kSupported = std::is_arithmetic_v<T>;
+
+//  Whether Multiply handles lhs * rhs better than the general engines.
+template <class T>
+bool IsSkinny(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs) {
+    return IsTallSkinny(lhs.Rows(), lhs.Columns(), rhs.Columns()) ||
+           IsInnerHeavy(lhs.Rows(), lhs.Columns(), rhs.Columns());
+}
+
+}  // namespace detail_skinny
+
+//  lhs * rhs for tall-skinny operands, e.g. 1000000 x 32 times 32 x 32: rhs is packed once and
+//  lhs rows are streamed through the packed kernel, split between the executor's threads.
+template <class T>
+Matrix<T> TallSkinnyMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                                   Executor* executor = nullptr) {
+    assert(lhs.Columns() == rhs.Rows());
+
+    Matrix<T> result(lhs.Rows(), rhs.Columns(), kUninitialized);
+    detail_skinny::TallSkinny(lhs.Data(), lhs.Columns(), PackedMatrix<T>(rhs), lhs.Rows(),
+                              result.Data(), result.Columns(), executor);
+
+    return result;
+}
+
+//  lhs * rhs for a long inner dimension, e.g. 64 x 1000000 times 1000000 x 64: the inner
+//  dimension is split between the executor's threads and the partial products are summed.
+template <class T>
+Matrix<T> SplitKMultiplication(const Matrix<T>& lhs, const Matrix<T>& rhs,
+                               Executor* executor = nullptr) {
+    assert(lhs.Columns() == rhs.Rows());
+
+    Matrix<T> result(lhs.Rows(), rhs.Columns(), kUninitialized);
+    detail_skinny::SplitK(lhs.Data(), lhs.Columns(), rhs.Data(), rhs.Columns(), lhs.Rows(),
+                          lhs.Columns(), rhs.Columns(), result.Data(), result.Columns(),
+                          executor);
+
+    return result;
+}
+
+}  // namespace s_fast
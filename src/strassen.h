@@ -1,12 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <deque>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "cache_oblivious_multpiplication.h"
+#include "epilogue.h"
+#include "executor.h"
 #include "matrix.h"
+#include "morton_matrix.h"
 #include "simd_multiplication.h"
+#include "skinny_multiplication.h"
 #include "view_matrix.h"
 #include "utils.h"
 
@@ -14,67 +22,424 @@ namespace s_fast {
 
 namespace detail_strassen {
 
+//  result += lhs * rhs for leaf blocks, accumulated in place row by row as scaled rhs rows. Parts
+//  of the views beyond their matrices are zero and skipped.
 template <class T>
-Matrix<T> Strassen(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs) {
-    using utils::BlockMatrix;
+void AccumulateLeaf(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs,
+                    ViewMatrix<T>& result) {
+    using Index = utils::Index;
+
+    Index rows = std::min(lhs.ExistedRows(), result.ExistedRows());
+    Index inner = std::min(lhs.ExistedColumns(), rhs.ExistedRows());
+    Index columns = std::min(rhs.ExistedColumns(), result.ExistedColumns());
+
+    for (Index row = 0; row < rows; ++row) {
+        const T* lhs_row = lhs.Data() + row * lhs.Stride();
+        T* result_row = result.Data() + row * result.Stride();
+
+        for (Index k = 0; k < inner; ++k) {
+            detail_simd::Axpy(lhs_row[k], rhs.Data() + k * rhs.Stride(), result_row, columns);
+        }
+    }
+}
+
+//  Buffers of one recursion level: the two quadrant sums and the product they are multiplied
+//  into. Every call on a level reuses them, so a whole product allocates only a few buffers per
+//  level instead of a dozen temporaries per call.
+template <class T>
+struct Workspace {
+    Matrix<T> lhs;
+    Matrix<T> rhs;
+    Matrix<T> product;
+};
+
+//  A deque: levels are added while deeper calls hold references to the ones above.
+template <class T>
+using Workspaces = std::deque<Workspace<T>>;
+
+//  *result = lhs + rhs, or lhs - rhs, over the whole padded quadrants.
+template <class T>
+void Combine(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs, bool subtract,
+             Matrix<T>* result) {
+    using Index = utils::Index;
+
+    assert(lhs.Rows() == rhs.Rows() && lhs.Columns() == rhs.Columns());
+
+    result->Reset(lhs.Rows(), lhs.Columns(), kUninitialized);
+
+    Index columns = result->Columns();
+    Index lhs_columns = std::clamp<Index>(lhs.ExistedColumns(), 0, columns);
+    Index rhs_columns = std::clamp<Index>(rhs.ExistedColumns(), 0, columns);
+
+    for (Index row = 0; row < result->Rows(); ++row) {
+        T* out = result->Data() + row * columns;
+
+        if (row < lhs.ExistedRows()) {
+            std::copy(lhs.Data() + row * lhs.Stride(),
+                      lhs.Data() + row * lhs.Stride() + lhs_columns, out);
+            std::fill(out + lhs_columns, out + columns, T(0));
+        } else {
+            std::fill(out, out + columns, T(0));
+        }
+
+        if (row < rhs.ExistedRows()) {
+            const T* from = rhs.Data() + row * rhs.Stride();
+            for (Index column = 0; column < rhs_columns; ++column) {
+                if (subtract) {
+                    out[column] -= from[column];
+                } else {
+                    out[column] += from[column];
+                }
+            }
+        }
+    }
+}
+
+//  result += lhs * rhs, accumulated straight into the quadrants of result. m1..m5 go through the
+//  product buffer of the level, m6 and m7 feed a single quadrant and are accumulated into it by
+//  the recursive call itself. Quadrant sums are built in the level's workspace.
+template <class T>
+void Strassen(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs, ViewMatrix<T>& result,
+              Workspaces<T>* workspaces, size_t level) {
     using utils::GetSubMatrixesStrassen;
     using utils::kStopStrassenConstant;
-    using utils::SetSubMatrix;
 
     assert(lhs.Columns() == rhs.Rows());
+    assert(result.Rows() == lhs.Rows() && result.Columns() == rhs.Columns());
+
+    if constexpr (detail_skinny::kSupported<T>) {
+        if (detail_skinny::IsSkinny(lhs, rhs)) {
+            result += detail_skinny::Multiply(lhs, rhs);
+            return;
+        }
+    }
 
     if (std::min({lhs.Rows(), lhs.Columns(), rhs.Columns()}) <= kStopStrassenConstant) {
-        return SimdMultiplication(GetMatrix(lhs), GetMatrix(rhs));
+        if constexpr (std::is_arithmetic_v<T>) {
+            AccumulateLeaf(lhs, rhs, result);
+        } else {
+            result += SimdMultiplication(GetMatrix(lhs), GetMatrix(rhs));
+        }
+        return;
     }
 
-    auto lhs_sub = GetSubMatrixesStrassen<const ConstViewMatrix<T>, ConstViewMatrix<T>>(lhs);
-    auto rhs_sub = GetSubMatrixesStrassen<const ConstViewMatrix<T>, ConstViewMatrix<T>>(rhs);
-
-    Matrix<T> m1 =
-        Strassen(lhs_sub.left_top + lhs_sub.right_bottom, rhs_sub.left_top + rhs_sub.right_bottom);
-    Matrix<T> m2 = Strassen(lhs_sub.left_bottom + lhs_sub.right_bottom, rhs_sub.left_top);
-    Matrix<T> m3 = Strassen(lhs_sub.left_top, rhs_sub.right_top - rhs_sub.right_bottom);
-    Matrix<T> m4 = Strassen(lhs_sub.right_bottom, rhs_sub.left_bottom - rhs_sub.left_top);
-    Matrix<T> m5 = Strassen(lhs_sub.left_top + lhs_sub.right_top, rhs_sub.right_bottom);
-    Matrix<T> m6 =
-        Strassen(lhs_sub.left_bottom - lhs_sub.left_top, rhs_sub.left_top + rhs_sub.right_top);
-    Matrix<T> m7 = Strassen(lhs_sub.right_top - lhs_sub.right_bottom,
-                            rhs_sub.left_bottom + rhs_sub.right_bottom);
-
-    m7 += m1;
-    m7 += m4;
-    m7 -= m5;
-    m5 += m3;
-    m4 += m2;
-    m1 -= m2;
-    m1 += m3;
-    m1 += m6;
+    auto a = GetSubMatrixesStrassen<const ConstViewMatrix<T>, ConstViewMatrix<T>>(lhs);
+    auto b = GetSubMatrixesStrassen<const ConstViewMatrix<T>, ConstViewMatrix<T>>(rhs);
+    auto c = GetSubMatrixesStrassen<ViewMatrix<T>, ViewMatrix<T>>(result);
+
+    if (workspaces->size() == level) {
+        workspaces->emplace_back();
+    }
+    Workspace<T>& workspace = (*workspaces)[level];
+    Matrix<T>& product = workspace.product;
+
+    auto lhs_sum = [&](const ConstViewMatrix<T>& x, const ConstViewMatrix<T>& y, bool subtract) {
+        Combine(x, y, subtract, &workspace.lhs);
+        return ConstViewMatrix<T>(workspace.lhs);
+    };
+    auto rhs_sum = [&](const ConstViewMatrix<T>& x, const ConstViewMatrix<T>& y, bool subtract) {
+        Combine(x, y, subtract, &workspace.rhs);
+        return ConstViewMatrix<T>(workspace.rhs);
+    };
+    auto multiply = [&](const ConstViewMatrix<T>& x, const ConstViewMatrix<T>& y) {
+        product.Reset(x.Rows(), y.Columns());
+        ViewMatrix<T> product_view(product);
+        Strassen(x, y, product_view, workspaces, level + 1);
+    };
+    auto accumulate = [&](const ConstViewMatrix<T>& x, const ConstViewMatrix<T>& y,
+                          ViewMatrix<T>& to) { Strassen(x, y, to, workspaces, level + 1); };
+
+    multiply(lhs_sum(a.left_top, a.right_bottom, false),
+             rhs_sum(b.left_top, b.right_bottom, false));
+    c.left_top += product;
+    c.right_bottom += product;
+
+    multiply(lhs_sum(a.left_bottom, a.right_bottom, false), b.left_top);
+    c.left_bottom += product;
+    c.right_bottom -= product;
+
+    multiply(a.left_top, rhs_sum(b.right_top, b.right_bottom, true));
+    c.right_top += product;
+    c.right_bottom += product;
+
+    multiply(a.right_bottom, rhs_sum(b.left_bottom, b.left_top, true));
+    c.left_top += product;
+    c.left_bottom += product;
+
+    multiply(lhs_sum(a.left_top, a.right_top, false), b.right_bottom);
+    c.left_top -= product;
+    c.right_top += product;
+
+    accumulate(lhs_sum(a.left_bottom, a.left_top, true), rhs_sum(b.left_top, b.right_top, false),
+               c.right_bottom);
+    accumulate(lhs_sum(a.right_top, a.right_bottom, true),
+               rhs_sum(b.left_bottom, b.right_bottom, false), c.left_top);
+}
+
+template <class T>
+void Strassen(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs,
+              ViewMatrix<T>& result) {
+    Workspaces<T> workspaces;
+    Strassen(lhs, rhs, result, &workspaces, 0);
+}
+
+//  Whether the recursion splits lhs * rhs into quadrants at the top, rather than sending it to the
+//  skinny kernels or the leaf.
+template <class T>
+bool SplitsAtTop(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs) {
+    if constexpr (detail_skinny::kSupported<T>) {
+        if (detail_skinny::IsSkinny(lhs, rhs)) {
+            return false;
+        }
+    }
+    return std::min({lhs.Rows(), lhs.Columns(), rhs.Columns()}) > utils::kStopStrassenConstant;
+}
+
+//  m[i] = i-th of the seven Strassen products of the top level quadrants, each a sequential
+//  recursion with its own sums and workspaces.
+template <class T>
+void TopLevelProduct(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs, int index,
+                     Matrix<T>* product) {
+    using utils::GetSubMatrixesStrassen;
+
+    auto a = GetSubMatrixesStrassen<const ConstViewMatrix<T>, ConstViewMatrix<T>>(lhs);
+    auto b = GetSubMatrixesStrassen<const ConstViewMatrix<T>, ConstViewMatrix<T>>(rhs);
+
+    Matrix<T> lhs_sum;
+    Matrix<T> rhs_sum;
+    auto sum = [](const ConstViewMatrix<T>& x, const ConstViewMatrix<T>& y, bool subtract,
+                  Matrix<T>* to) {
+        Combine(x, y, subtract, to);
+        return ConstViewMatrix<T>(*to);
+    };
+    auto multiply = [&](const ConstViewMatrix<T>& x, const ConstViewMatrix<T>& y) {
+        product->Reset(x.Rows(), y.Columns());
+        ViewMatrix<T> product_view(*product);
+        Strassen(x, y, product_view);
+    };
+
+    switch (index) {
+        case 0:
+            multiply(sum(a.left_top, a.right_bottom, false, &lhs_sum),
+                     sum(b.left_top, b.right_bottom, false, &rhs_sum));
+            break;
+        case 1:
+            multiply(sum(a.left_bottom, a.right_bottom, false, &lhs_sum), b.left_top);
+            break;
+        case 2:
+            multiply(a.left_top, sum(b.right_top, b.right_bottom, true, &rhs_sum));
+            break;
+        case 3:
+            multiply(a.right_bottom, sum(b.left_bottom, b.left_top, true, &rhs_sum));
+            break;
+        case 4:
+            multiply(sum(a.left_top, a.right_top, false, &lhs_sum), b.right_bottom);
+            break;
+        case 5:
+            multiply(sum(a.left_bottom, a.left_top, true, &lhs_sum),
+                     sum(b.left_top, b.right_top, false, &rhs_sum));
+            break;
+        default:
+            multiply(sum(a.right_top, a.right_bottom, true, &lhs_sum),
+                     sum(b.left_bottom, b.right_bottom, false, &rhs_sum));
+            break;
+    }
+}
+
+//  With an executor the seven products of the top level are independent tasks, so every thread
+//  runs a real Strassen recursion on a quarter sized problem; the four result quadrants are then
+//  assembled in parallel. At most seven threads are busy during the products. Shapes that do not
+//  split at the top (skinny ones and those at the cutoff) are not Strassen products anyway and
+//  are cut into row slabs instead. The epilogue runs over finished rows, split between threads.
+template <class T, class Op>
+Matrix<T> Strassen(const ConstViewMatrix<T>& lhs, const ConstViewMatrix<T>& rhs,
+                   Executor* executor, const Epilogue<Op>& epilogue) {
+    using Index = utils::Index;
+    using utils::GetSubMatrixesStrassen;
+
+    constexpr int kProducts = 7;
 
     Matrix<T> result(lhs.Rows(), rhs.Columns());
+    ViewMatrix<T> result_view(result);
+
+    Index threads = executor == nullptr ? 1 : static_cast<Index>(executor->Concurrency());
+    if (threads == 1) {
+        Strassen(lhs, rhs, result_view);
+        epilogue.ApplyRows(&result, 0, result.Rows());
+        return result;
+    }
+
+    Index grain = std::max<Index>(1, (lhs.Rows() + threads - 1) / threads);
+
+    if (!SplitsAtTop(lhs, rhs)) {
+        ParallelFor(*executor, lhs.Rows(), grain, [&](Index begin, Index end) {
+            ConstViewMatrix<T> lhs_rows(lhs, {begin, 0}, {end, lhs.Columns()});
+            ViewMatrix<T> result_rows(result_view, {begin, 0}, {end, result.Columns()});
+            Strassen(lhs_rows, rhs, result_rows);
+            epilogue.ApplyRows(&result, begin, end);
+        });
+        return result;
+    }
+
+    std::vector<Matrix<T>> products(kProducts);
+    ParallelFor(*executor, kProducts, 1, [&](Index begin, Index end) {
+        for (Index i = begin; i < end; ++i) {
+            TopLevelProduct(lhs, rhs, static_cast<int>(i), &products[i]);
+        }
+    });
+
+    auto c = GetSubMatrixesStrassen<ViewMatrix<T>, ViewMatrix<T>>(result_view);
+    ParallelFor(*executor, 4, 1, [&](Index begin, Index end) {
+        for (Index quadrant = begin; quadrant < end; ++quadrant) {
+            if (quadrant == 0) {
+                c.left_top += products[0];
+                c.left_top += products[3];
+                c.left_top -= products[4];
+                c.left_top += products[6];
+            } else if (quadrant == 1) {
+                c.right_top += products[2];
+                c.right_top += products[4];
+            } else if (quadrant == 2) {
+                c.left_bottom += products[1];
+                c.left_bottom += products[3];
+            } else {
+                c.right_bottom += products[0];
+                c.right_bottom -= products[1];
+                c.right_bottom += products[2];
+                c.right_bottom += products[5];
+            }
+        }
+    });
 
-    SetSubMatrix<T>(m7, {0, 0}, &result);
-    SetSubMatrix<T>(m5, {0, m7.Columns()}, &result);
-    SetSubMatrix<T>(m4, {m7.Rows(), 0}, &result);
-    SetSubMatrix<T>(m1, {m7.Rows(), m7.Columns()}, &result);
+    ParallelFor(*executor, result.Rows(), grain,
+                [&](Index begin, Index end) { epilogue.ApplyRows(&result, begin, end); });
 
     return result;
 }
 
+template <class T>
+void Add(const T* lhs, const T* rhs, T* result, utils::Index size) {
+    for (utils::Index i = 0; i < size; ++i) {
+        result[i] = lhs[i] + rhs[i];
+    }
+}
+
+template <class T>
+void Subtract(const T* lhs, const T* rhs, T* result, utils::Index size) {
+    for (utils::Index i = 0; i < size; ++i) {
+        result[i] = lhs[i] - rhs[i];
+    }
+}
+
+//  result += lhs * rhs for Morton blocks of tiles x tiles tiles. Quadrant sums are plain loops over
+//  contiguous ranges; m6 and m7 feed a single quadrant and are accumulated into it directly.
+template <class T>
+void Strassen(const T* lhs, const T* rhs, T* result, utils::Index tiles) {
+    using Index = utils::Index;
+    using detail_morton::kTileElements;
+    using utils::kStopMortonStrassenTiles;
+
+    if (tiles <= kStopMortonStrassenTiles) {
+        detail_cache_oblivious::CacheObliviousMult(lhs, rhs, result, tiles);
+        return;
+    }
+
+    Index half = tiles / 2;
+    Index quadrant = half * half * kTileElements;
+
+    const T* a[4] = {lhs, lhs + quadrant, lhs + 2 * quadrant, lhs + 3 * quadrant};
+    const T* b[4] = {rhs, rhs + quadrant, rhs + 2 * quadrant, rhs + 3 * quadrant};
+    T* c[4] = {result, result + quadrant, result + 2 * quadrant, result + 3 * quadrant};
+
+    std::vector<T> lhs_sum(quadrant);
+    std::vector<T> rhs_sum(quadrant);
+    std::vector<T> product(quadrant);
+
+    auto multiply = [&](const T* x, const T* y) {
+        std::fill(product.begin(), product.end(), 0);
+        Strassen(x, y, product.data(), half);
+    };
+    auto add_to = [&](T* to) {
+        Add(to, product.data(), to, quadrant);
+    };
+    auto subtract_from = [&](T* to) {
+        Subtract(to, product.data(), to, quadrant);
+    };
+
+    Add(a[0], a[3], lhs_sum.data(), quadrant);
+    Add(b[0], b[3], rhs_sum.data(), quadrant);
+    multiply(lhs_sum.data(), rhs_sum.data());
+    add_to(c[0]);
+    add_to(c[3]);
+
+    Add(a[2], a[3], lhs_sum.data(), quadrant);
+    multiply(lhs_sum.data(), b[0]);
+    add_to(c[2]);
+    subtract_from(c[3]);
+
+    Subtract(b[1], b[3], rhs_sum.data(), quadrant);
+    multiply(a[0], rhs_sum.data());
+    add_to(c[1]);
+    add_to(c[3]);
+
+    Subtract(b[2], b[0], rhs_sum.data(), quadrant);
+    multiply(a[3], rhs_sum.data());
+    add_to(c[0]);
+    add_to(c[2]);
+
+    Add(a[0], a[1], lhs_sum.data(), quadrant);
+    multiply(lhs_sum.data(), b[3]);
+    subtract_from(c[0]);
+    add_to(c[1]);
+
+    Subtract(a[2], a[0], lhs_sum.data(), quadrant);
+    Add(b[0], b[1], rhs_sum.data(), quadrant);
+    Strassen(lhs_sum.data(), rhs_sum.data(), c[3], half);
+
+    Subtract(a[1], a[3], lhs_sum.data(), quadrant);
+    Add(b[2], b[3], rhs_sum.data(), quadrant);
+    Strassen(lhs_sum.data(), rhs_sum.data(), c[0], half);
+}
+
 }  // namespace detail_strassen
 
 template <class T>
-Matrix<T> Strassen(const Matrix<T>& lhs, const Matrix<T>& rhs) {
-    return detail_strassen::Strassen(ConstViewMatrix<T>(lhs), ConstViewMatrix<T>(rhs));
+Matrix<T> Strassen(const Matrix<T>& lhs, const Matrix<T>& rhs, Executor* executor = nullptr) {
+    return detail_strassen::Strassen(ConstViewMatrix<T>(lhs), ConstViewMatrix<T>(rhs), executor,
+                                     NoEpilogue());
+}
+
+//  lhs * rhs with the epilogue fused in. Quadrants of the result are final only at the end of
+//  the recursion, so the epilogue runs once per row of a finished block: all its operations in
+//  one pass, split between the executor's threads.
+template <class T, class Op>
+Matrix<T> Strassen(const Matrix<T>& lhs, const Matrix<T>& rhs, const Epilogue<Op>& epilogue,
+                   Executor* executor = nullptr) {
+    return detail_strassen::Strassen(ConstViewMatrix<T>(lhs), ConstViewMatrix<T>(rhs), executor,
+                                     epilogue);
 }
 
 template <class T>
-Matrix<T> Strassen(const ConstViewMatrix<T>& lhs, const Matrix<T>& rhs) {
-    return detail_strassen::Strassen(lhs, ConstViewMatrix<T>(rhs));
+Matrix<T> Strassen(const ConstViewMatrix<T>& lhs, const Matrix<T>& rhs,
+                   Executor* executor = nullptr) {
+    return detail_strassen::Strassen(lhs, ConstViewMatrix<T>(rhs), executor, NoEpilogue());
 }
 
 template <class T>
-Matrix<T> Strassen(const Matrix<T>& lhs, const ConstViewMatrix<T>& rhs) {
-    return detail_strassen::Strassen(ConstViewMatrix<T>(lhs), rhs);
+Matrix<T> Strassen(const Matrix<T>& lhs, const ConstViewMatrix<T>& rhs,
+                   Executor* executor = nullptr) {
+    return detail_strassen::Strassen(ConstViewMatrix<T>(lhs), rhs, executor, NoEpilogue());
+}
+
+template <class T>
+MortonMatrix<T> Strassen(const MortonMatrix<T>& lhs, const MortonMatrix<T>& rhs) {
+    assert(lhs.Columns() == rhs.Rows() && lhs.TilesPerSide() == rhs.TilesPerSide());
+
+    MortonMatrix<T> result(lhs.Rows(), rhs.Columns(), lhs.TilesPerSide());
+
+    detail_strassen::Strassen(lhs.Data(), rhs.Data(), result.Data(), lhs.TilesPerSide());
+
+    return result;
 }
 
 }  // namespace s_fast
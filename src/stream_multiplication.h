@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "executor.h"
+#include "matrix.h"
+#include "packed_matrix.h"
+#include "utils.h"
+
+namespace s_fast {
+
+namespace detail_stream {
+
+using Index = utils::Index;
+
+//  Row chunks of one product submitted to an executor without waiting for them, so that the
+//  calling thread can read the next block meanwhile. Wait blocks until all chunks are done and
+//  rethrows the first exception of a chunk; the destructor waits too, so chunks never outlive the
+//  data they use.
+class PendingChunks {
+public:
+    PendingChunks() = default;
+
+    PendingChunks(const PendingChunks&) = delete;
+    PendingChunks& operator=(const PendingChunks&) = delete;
+
+    ~PendingChunks() {
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return chunks_left_ == 0; });
+    }
+
+    //  Submits body(begin, end) for chunks of [0, size) of at most grain elements.
+    template <class Body>
+    void Start(Executor& executor, Index size, Index grain, Body body) {
+        Index chunks = (size + grain - 1) / grain;
+        {
+            std::lock_guard lock(mutex_);
+            chunks_left_ = chunks;
+            error_ = nullptr;
+        }
+
+        for (Index begin = 0; begin < size; begin += grain) {
+            Index end = std::min(size, begin + grain);
+            executor.SubmitPart(
+                [this, body, begin, end] {
+                    std::exception_ptr error;
+                    try {
+                        body(begin, end);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+
+                    std::lock_guard lock(mutex_);
+                    if (error && !error_) {
+                        error_ = error;
+                    }
+                    if (--chunks_left_ == 0) {
+                        done_.notify_all();
+                    }
+                },
+                begin / grain, chunks);
+        }
+    }
+
+    void Wait() {
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return chunks_left_ == 0; });
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    Index chunks_left_ = 0;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+}  // namespace detail_stream
+
+//  Multiplies a stream of row blocks of lhs by rhs. bool reader(Matrix<T>* block) fills block with
+//  the next rows of lhs (any number of them, rhs.Rows() columns, reusing the given matrix) and
+//  returns false at the end of the input. sink(const Matrix<T>& block) gets the matching rows of
+//  the product in order. Everything runs on the calling thread and the executor: with an executor
+//  the rows of block i are multiplied by its threads while the calling thread reads block i + 1;
+//  without one reading and multiplying alternate. At most two input blocks and one output block
+//  are alive. Exceptions of the reader and the sink are propagated once no task uses the blocks.
+template <class T, class Reader, class Sink>
+void MultiplyStream(Reader reader, const PackedMatrix<T>& rhs, Sink sink,
+                    Executor* executor = nullptr) {
+    using detail_stream::Index;
+    using utils::kAsyncRowBlockSize;
+
+    Matrix<T> blocks[2];
+    Matrix<T> product;
+
+    if (!reader(&blocks[0])) {
+        return;
+    }
+
+    for (size_t block = 0;; ++block) {
+        const Matrix<T>& lhs = blocks[block % 2];
+        assert(lhs.Columns() == rhs.Rows());
+
+        if (executor == nullptr) {
+            SimdMultiplication(lhs, rhs, &product);
+            sink(std::as_const(product));
+            if (!reader(&blocks[(block + 1) % 2])) {
+                return;
+            }
+            continue;
+        }
+
+        product.Reset(lhs.Rows(), rhs.Columns(), kUninitialized);
+
+        bool has_next = false;
+        {
+            detail_stream::PendingChunks pending;
+            pending.Start(*executor, lhs.Rows(), kAsyncRowBlockSize, [&](Index begin, Index end) {
+                detail_packed::MultiplyRows(lhs, rhs, begin, end, &product);
+            });
+
+            std::exception_ptr read_error;
+            try {
+                has_next = reader(&blocks[(block + 1) % 2]);
+            } catch (...) {
+                read_error = std::current_exception();
+            }
+
+            pending.Wait();
+            if (read_error) {
+                std::rethrow_exception(read_error);
+            }
+        }
+
+        sink(std::as_const(product));
+        if (!has_next) {
+            return;
+        }
+    }
+}
+
+template <class T, class Reader, class Sink>
+void MultiplyStream(Reader reader, const Matrix<T>& rhs, Sink sink, Executor* executor = nullptr) {
+    MultiplyStream(std::move(reader), PackedMatrix<T>(rhs), std::move(sink), executor);
+}
+
+}  // namespace s_fast
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+#include "executor.h"
+#include "matrix.h"
+#include "simd_multiplication.h"
+#include "utils.h"
+
+namespace s_fast {
+
+enum class Triangle { kLower, kUpper };
+
+//  Which Gram matrix Syrk computes: kRows is a * a^T, kColumns is a^T * a.
+enum class Gram { kRows, kColumns };
+
+namespace detail_symmetric {
+
+using Index = utils::Index;
+
+constexpr Index kBlockSize = 32;
+
+//  Columns [first, last) of row `row` that belong to the triangle of a size x size matrix.
+inline Index TriangleBegin(Triangle triangle, Index row) {
+    return triangle == Triangle::kLower ? 0 : row;
+}
+
+inline Index TriangleEnd(Triangle triangle, Index row, Index size) {
+    return triangle == Triangle::kLower ? row + 1 : size;
+}
+
+//  a * a^T: every element is a dot product of two rows of a. Blocks of result are visited only if
+//  they intersect the triangle, so both rows of a block pair stay in cache. Fills result rows
+//  [row_begin, row_end), row_begin is a multiple of kBlockSize.
+template <class T>
+void SyrkRows(const Matrix<T>& a, Triangle triangle, Index row_begin, Index row_end,
+              Matrix<T>* result) {
+    Index size = a.Rows();
+    Index inner = a.Columns();
+
+    for (Index row_block = row_begin; row_block < row_end; row_block += kBlockSize) {
+        Index row_block_end = std::min(row_end, row_block + kBlockSize);
+
+        for (Index column_block = 0; column_block < size; column_block += kBlockSize) {
+            Index column_block_end = std::min(size, column_block + kBlockSize);
+
+            if (triangle == Triangle::kLower ? column_block > row_block
+                                             : column_block_end <= row_block) {
+                continue;
+            }
+
+            for (Index row = row_block; row < row_block_end; ++row) {
+                Index first = std::max(column_block, TriangleBegin(triangle, row));
+                Index last = std::min(column_block_end, TriangleEnd(triangle, row, size));
+
+                for (Index column = first; column < last; ++column) {
+                    (*result)(row, column) = detail_simd::Dot(a.Data() + row * inner,
+                                                              a.Data() + column * inner, inner);
+                }
+            }
+        }
+    }
+}
+
+//  a^T * a as a sum of outer products of the rows of a, restricted to the triangle. Fills result
+//  rows [row_begin, row_end).
+template <class T>
+void SyrkColumns(const Matrix<T>& a, Triangle triangle, Index row_begin, Index row_end,
+                 Matrix<T>* result) {
+    Index size = a.Columns();
+
+    for (Index block = row_begin; block < row_end; block += kBlockSize) {
+        Index block_end = std::min(row_end, block + kBlockSize);
+
+        for (Index k = 0; k < a.Rows(); ++k) {
+            const T* a_row = a.Data() + k * size;
+
+            for (Index row = block; row < block_end; ++row) {
+                Index first = TriangleBegin(triangle, row);
+                Index last = TriangleEnd(triangle, row, size);
+
+                detail_simd::Axpy(a_row[row], a_row + first, result->Data() + row * size + first,
+                                  last - first);
+            }
+        }
+    }
+}
+
+}  // namespace detail_symmetric
+
+//  Symmetric rank-k update: a * a^T or a^T * a, computing only the given triangle of the result.
+//  The other triangle is left zero, use Symmetrize to fill it. With an executor blocks of result
+//  rows are split between its threads; they are small since rows of the triangle differ in length.
+template <class T>
+Matrix<T> Syrk(const Matrix<T>& a, Gram gram = Gram::kRows, Triangle triangle = Triangle::kLower,
+               Executor* executor = nullptr) {
+    using detail_symmetric::Index;
+    using detail_symmetric::kBlockSize;
+
+    Index size = gram == Gram::kRows ? a.Rows() : a.Columns();
+    Matrix<T> result(size, size);
+
+    ParallelFor(executor, size, kBlockSize, [&](Index row_begin, Index row_end) {
+        if (gram == Gram::kRows) {
+            detail_symmetric::SyrkRows(a, triangle, row_begin, row_end, &result);
+        } else {
+            detail_symmetric::SyrkColumns(a, triangle, row_begin, row_end, &result);
+        }
+    });
+
+    return result;
+}
+
+//  Copies the stored triangle of a square matrix into the other one.
+template <class T>
+void Symmetrize(Matrix<T>* matrix, Triangle stored = Triangle::kLower) {
+    using Index = typename Matrix<T>::Index;
+
+    assert(matrix->Rows() == matrix->Columns());
+
+    for (Index row = 0; row < matrix->Rows(); ++row) {
+        for (Index column = 0; column < row; ++column) {
+            if (stored == Triangle::kLower) {
+                (*matrix)(column, row) = (*matrix)(row, column);
+            } else {
+                (*matrix)(row, column) = (*matrix)(column, row);
+            }
+        }
+    }
+}
+
+//  triangular * rhs, reading only the given triangle of the square matrix `triangular`. Row i of
+//  the result accumulates just the rhs rows the triangle of row i touches, half of a full product.
+template <class T>
+Matrix<T> Trmm(const Matrix<T>& triangular, Triangle triangle, const Matrix<T>& rhs,
+               Executor* executor = nullptr) {
+    using Index = typename Matrix<T>::Index;
+
+    assert(triangular.Rows() == triangular.Columns());
+    assert(triangular.Columns() == rhs.Rows());
+
+    Index size = triangular.Rows();
+    Index columns = rhs.Columns();
+    Matrix<T> result(size, columns);
+
+    ParallelFor(executor, size, detail_symmetric::kBlockSize, [&](Index row_begin, Index row_end) {
+        for (Index row = row_begin; row < row_end; ++row) {
+            Index first = detail_symmetric::TriangleBegin(triangle, row);
+            Index last = detail_symmetric::TriangleEnd(triangle, row, size);
+
+            for (Index k = first; k < last; ++k) {
+                detail_simd::Axpy(triangular(row, k), rhs.Data() + k * columns,
+                                  result.Data() + row * columns, columns);
+            }
+        }
+    });
+
+    return result;
+}
+
+}  // namespace s_fast
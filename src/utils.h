@@ -11,6 +11,13 @@ using Position = typename Matrix<int>::Position;
 
 constexpr Index kStopStrassenConstant = 16;
 constexpr Index kStopCacheObliviousConstant = 16;
+constexpr Index kAsyncRowBlockSize = 64;
+constexpr Index kChainStrassenConstant = 256;
+constexpr Index kStopMortonStrassenTiles = 2;
+constexpr Index kPowerMortonConstant = 256;
+constexpr Index kSharedMemoryTileSize = 256;
+constexpr Index kSkinnyConstant = 128;
+constexpr Index kSkinnyRatio = 16;
 
 template <class ContainerType>
 struct BlockMatrix {
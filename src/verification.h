@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "executor.h"
+#include "matrix.h"
+#include "simd_multiplication.h"
+#include "utils.h"
+
+namespace s_fast {
+
+class VerificationError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail_verification {
+
+using Index = utils::Index;
+
+template <class T>
+struct Real {
+    using Type = T;
+};
+
+template <class T>
+struct Real<std::complex<T>> {
+    using Type = T;
+};
+
+//  Floating point results are compared up to rounding, everything else (integers, ModInt) exactly.
+template <class T>
+constexpr bool kApproximate = std::is_floating_point_v<typename Real<T>::Type>;
+
+//  result[row] = <matrix row, vector> for rows [row_begin, row_end).
+template <class T>
+void MultiplyVector(const Matrix<T>& matrix, const std::vector<T>& vector, Index row_begin,
+                    Index row_end, std::vector<T>* result) {
+    for (Index row = row_begin; row < row_end; ++row) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            (*result)[row] = detail_simd::Dot(matrix.Data() + row * matrix.Columns(),
+                                              vector.data(), matrix.Columns());
+        } else {
+            T sum(0);
+            for (Index k = 0; k < matrix.Columns(); ++k) {
+                sum += matrix(row, k) * vector[k];
+            }
+            (*result)[row] = sum;
+        }
+    }
+}
+
+//  result[row] = sum of |matrix(row, k)| * vector[k].
+template <class T, class R>
+void MultiplyAbsVector(const Matrix<T>& matrix, const std::vector<R>& vector, Index row_begin,
+                       Index row_end, std::vector<R>* result) {
+    for (Index row = row_begin; row < row_end; ++row) {
+        R sum = 0;
+        for (Index k = 0; k < matrix.Columns(); ++k) {
+            sum += std::abs(matrix(row, k)) * vector[k];
+        }
+        (*result)[row] = sum;
+    }
+}
+
+template <class Body>
+void ForRows(Executor* executor, Index rows, Body body) {
+    if (executor == nullptr) {
+        body(Index{0}, rows);
+    } else {
+        ParallelFor(*executor, rows, utils::kAsyncRowBlockSize, body);
+    }
+}
+
+inline std::mt19937_64& RandomEngine() {
+    thread_local std::mt19937_64 random(std::random_device{}());
+    return random;
+}
+
+}  // namespace detail_verification
+
+//  Freivalds' check of c == a * b: for a random x it compares a * (b * x) with c * x, which costs
+//  three matrix-vector products per trial instead of a multiplication. Exact types draw x from
+//  {0, 1}, so that a wrong c passes a trial with probability at most 1/2 even in characteristic 2
+//  or with wrap-around unsigned arithmetic, where +-1 entries would let errors like 2^31 in two
+//  elements of a row cancel in every trial. Exact types are compared exactly.
+//  Floating point keeps +-1 entries, and its rows are accepted if they differ by at most
+//  tolerance * max over rows of |a| |b| |x|; tolerance 0 selects 2 * (inner + 2) * epsilon. The
+//  bound is normwise rather than per row because Strassen is only normwise stable: a row of small
+//  elements in a may get the rounding error of the large ones.
+template <class T>
+bool Verify(const Matrix<T>& a, const Matrix<T>& b, const Matrix<T>& c, int trials = 4,
+            double tolerance = 0, Executor* executor = nullptr) {
+    using detail_verification::ForRows;
+    using detail_verification::Index;
+    using Real = typename detail_verification::Real<T>::Type;
+
+    assert(a.Columns() == b.Rows());
+    assert(trials > 0);
+
+    if (c.Rows() != a.Rows() || c.Columns() != b.Columns()) {
+        return false;
+    }
+
+    Real bound = 0;
+    if constexpr (detail_verification::kApproximate<T>) {
+        if (tolerance == 0) {
+            tolerance = 2 * (a.Columns() + 2) * std::numeric_limits<Real>::epsilon();
+        }
+
+        std::vector<Real> ones(b.Columns(), 1);
+        std::vector<Real> b_bound(b.Rows());
+        std::vector<Real> row_bound(a.Rows());
+        ForRows(executor, b.Rows(), [&](Index begin, Index end) {
+            detail_verification::MultiplyAbsVector(b, ones, begin, end, &b_bound);
+        });
+        ForRows(executor, a.Rows(), [&](Index begin, Index end) {
+            detail_verification::MultiplyAbsVector(a, b_bound, begin, end, &row_bound);
+        });
+        for (Real row : row_bound) {
+            bound = std::max(bound, row);
+        }
+        bound *= tolerance;
+    }
+
+    std::vector<T> x(b.Columns(), T(0));
+    std::vector<T> bx(b.Rows(), T(0));
+    std::vector<T> abx(a.Rows(), T(0));
+    std::vector<T> cx(c.Rows(), T(0));
+
+    for (int trial = 0; trial < trials; ++trial) {
+        auto& random = detail_verification::RandomEngine();
+        for (auto& element : x) {
+            if constexpr (detail_verification::kApproximate<T>) {
+                element = (random() & 1) ? T(1) : T(-1);
+            } else {
+                element = (random() & 1) ? T(1) : T(0);
+            }
+        }
+
+        ForRows(executor, b.Rows(), [&](Index begin, Index end) {
+            detail_verification::MultiplyVector(b, x, begin, end, &bx);
+        });
+        ForRows(executor, a.Rows(), [&](Index begin, Index end) {
+            detail_verification::MultiplyVector(a, bx, begin, end, &abx);
+            detail_verification::MultiplyVector(c, x, begin, end, &cx);
+        });
+
+        for (Index row = 0; row < a.Rows(); ++row) {
+            if constexpr (detail_verification::kApproximate<T>) {
+                if (!(std::abs(abx[row] - cx[row]) <= bound)) {
+                    return false;
+                }
+            } else if (abx[row] != cx[row]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//  Wraps engine(a, b) so that every product is checked with Verify before it is returned. Throws
+//  VerificationError if the check fails.
+template <class Engine>
+auto Verified(Engine engine, int trials = 4, double tolerance = 0, Executor* executor = nullptr) {
+    return [engine = std::move(engine), trials, tolerance, executor](const auto& a,
+                                                                     const auto& b) {
+        auto c = engine(a, b);
+        if (!Verify(a, b, c, trials, tolerance, executor)) {
+            throw VerificationError("Matrix product failed verification");
+        }
+        return c;
+    };
+}
+
+}  // namespace s_fast
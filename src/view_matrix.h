@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include "matrix.h"
 #include "view_matrix_helper.h"
@@ -20,18 +21,25 @@ public:
     using MatrixType = view_matrix_helper::ContainerType<Matrix<T>, IsConst>;
     using ViewMatrixType = view_matrix_helper::ContainerType<RawViewMatrix<T, IsConst>, IsConst>;
 
+    //  A view may reach past its matrix; that part reads as zero.
     RawViewMatrix(MatrixType& matrix, Position begin = {0, 0}, Position end = {-1, -1})
         : matrix_(matrix),
           begin_(begin),
           end_({end.row == -1 ? matrix.Rows() : end.row,
-                end.column == -1 ? matrix.Columns() : end.column}) {
+                end.column == -1 ? matrix.Columns() : end.column}),
+          existed_end_({std::min(end_.row, matrix.Rows()),
+                        std::min(end_.column, matrix.Columns())}) {
     }
 
+    //  A sub-view may reach past its parent view; that part reads as zero too, even where the
+    //  matrix has elements, so padding never picks up the parent's neighbours.
     RawViewMatrix(ViewMatrixType& matrix, Position begin = {0, 0}, Position end = {-1, -1})
         : matrix_(matrix.matrix_),
           begin_({matrix.begin_.row + begin.row, matrix.begin_.column + begin.column}),
           end_({end.row == -1 ? matrix.end_.row : matrix.begin_.row + end.row,
-                end.column == -1 ? matrix.end_.column : matrix.begin_.column + end.column}) {
+                end.column == -1 ? matrix.end_.column : matrix.begin_.column + end.column}),
+          existed_end_({std::min(end_.row, matrix.existed_end_.row),
+                        std::min(end_.column, matrix.existed_end_.column)}) {
     }
 
     RawViewMatrix() = delete;
@@ -41,7 +49,7 @@ public:
     }
 
     Index ExistedRows() const {
-        return std::min(Rows(), matrix_.Rows() - begin_.row);
+        return existed_end_.row - begin_.row;
     }
 
     Index Columns() const {
@@ -49,12 +57,21 @@ public:
     }
 
     Index ExistedColumns() const {
-        return std::min(Columns(), matrix_.Columns() - begin_.column);
+        return existed_end_.column - begin_.column;
+    }
+
+    Index Stride() const {
+        return matrix_.Columns();
+    }
+
+    //  Pointer to the top left element. Rows are Stride() elements apart and only the existing
+    //  part of the view is addressable.
+    auto Data() const {
+        return matrix_.Data() + begin_.row * Stride() + begin_.column;
     }
 
     ReturnElementType operator()(Index row, Index column) {
-        assert(0 <= row && begin_.row + row < matrix_.Rows() && 0 <= column &&
-               begin_.column + column < matrix_.Columns());
+        assert(0 <= row && row < ExistedRows() && 0 <= column && column < ExistedColumns());
 
         return matrix_(begin_.row + row, begin_.column + column);
     }
@@ -62,7 +79,7 @@ public:
     ConstReturnElementType operator()(Index row, Index column) const {
         assert(0 <= row && row < Rows() && 0 <= column && column < Columns());
 
-        if (begin_.row + row >= matrix_.Rows() || begin_.column + column >= matrix_.Columns()) {
+        if (row >= ExistedRows() || column >= ExistedColumns()) {
             return 0;
         }
 
@@ -135,6 +152,8 @@ private:
 
     Position begin_;
     Position end_;
+    //  End of the part backed by elements of the view and all its parents.
+    Position existed_end_;
 };
 
 template <class T, bool IsConst>
@@ -142,6 +161,46 @@ bool operator!=(const RawViewMatrix<T, IsConst>& lhs, const RawViewMatrix<T, IsC
     return !(lhs == rhs);
 }
 
+//  Transposed view over a RawViewMatrix: rows and columns (and thus strides) are swapped,
+//  no element is copied.
+template <class T, bool IsConst>
+class RawTransposedViewMatrix {
+public:
+    using Index = typename Matrix<T>::Index;
+
+    using ReturnElementType = view_matrix_helper::ReturnIfConst<T, IsConst>;
+    using ConstReturnElementType = helper::ReturnAs<T>;
+
+    using BaseViewType = RawViewMatrix<T, IsConst>;
+
+    explicit RawTransposedViewMatrix(const BaseViewType& view) : view_(view) {
+    }
+
+    Index Rows() const {
+        return view_.Columns();
+    }
+
+    Index Columns() const {
+        return view_.Rows();
+    }
+
+    //  The view being transposed, i.e. the operand in its stored layout.
+    const BaseViewType& Base() const {
+        return view_;
+    }
+
+    ReturnElementType operator()(Index row, Index column) {
+        return view_(column, row);
+    }
+
+    ConstReturnElementType operator()(Index row, Index column) const {
+        return view_(column, row);
+    }
+
+private:
+    BaseViewType view_;
+};
+
 }  // namespace view_matrix_detail
 
 template <class T>
@@ -150,11 +209,27 @@ using ViewMatrix = view_matrix_detail::RawViewMatrix<T, false>;
 template <class T>
 using ConstViewMatrix = view_matrix_detail::RawViewMatrix<T, true>;
 
+template <class T>
+using TransposedViewMatrix = view_matrix_detail::RawTransposedViewMatrix<T, false>;
+
+template <class T>
+using ConstTransposedViewMatrix = view_matrix_detail::RawTransposedViewMatrix<T, true>;
+
+template <class T>
+ConstTransposedViewMatrix<T> TransposedView(const Matrix<T>& matrix) {
+    return ConstTransposedViewMatrix<T>(ConstViewMatrix<T>(matrix));
+}
+
+template <class T>
+ConstTransposedViewMatrix<T> TransposedView(const ConstViewMatrix<T>& view_matrix) {
+    return ConstTransposedViewMatrix<T>(view_matrix);
+}
+
 template <class T>
 Matrix<T> GetMatrix(const ViewMatrix<T>& view_matrix) {
     using Index = typename Matrix<T>::Index;
 
-    Matrix<T> matrix(view_matrix.Rows(), view_matrix.Columns());
+    Matrix<T> matrix(view_matrix.Rows(), view_matrix.Columns(), kUninitialized);
 
     for (Index i = 0; i < view_matrix.Rows(); ++i) {
         for (Index j = 0; j < view_matrix.Columns(); ++j) {
@@ -169,7 +244,7 @@ template <class T>
 Matrix<T> GetMatrix(const ConstViewMatrix<T>& view_matrix) {
     using Index = typename Matrix<T>::Index;
 
-    Matrix<T> matrix(view_matrix.Rows(), view_matrix.Columns());
+    Matrix<T> matrix(view_matrix.Rows(), view_matrix.Columns(), kUninitialized);
 
     for (Index i = 0; i < view_matrix.Rows(); ++i) {
         for (Index j = 0; j < view_matrix.Columns(); ++j) {
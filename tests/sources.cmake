@@ -6,4 +6,24 @@ add_executable(
   tests/test_simd_mult.cpp
   tests/test_view_matrix.cpp
   tests/test_cache_oblivious_mult.cpp
+  tests/test_async_mult.cpp
+  tests/test_chain_mult.cpp
+  tests/test_modular_mult.cpp
+  tests/test_morton_matrix.cpp
+  tests/test_power.cpp
+  tests/test_symmetric_mult.cpp
+  tests/test_shared_memory_mult.cpp
+  tests/test_numa.cpp
+  tests/test_allocator.cpp
+  tests/test_packed_mult.cpp
+  tests/test_stream_mult.cpp
+  tests/test_complex_mult.cpp
+  tests/test_verification.cpp
+  tests/test_convolution.cpp
+  tests/test_skinny_mult.cpp
+  tests/test_executor.cpp
+  tests/test_lu.cpp
+  tests/test_epilogue.cpp
+  tests/test_block_sparse.cpp
+  tests/test_incremental_product.cpp
 )
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "../src/allocator.h"
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/matrix.h"
+#include "../src/simple_multiplication.h"
+
+namespace {
+
+//  VmFlags of the mapping that holds pointer, e.g. " rd wr mr mw me ac hg": hg and nh are set by
+//  MADV_HUGEPAGE and MADV_NOHUGEPAGE. Empty where /proc/self/smaps is unavailable.
+std::string VmFlags(const void* pointer) {
+    std::ifstream smaps("/proc/self/smaps");
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    bool inside = false;
+    std::string line;
+
+    while (std::getline(smaps, line)) {
+        uintptr_t begin = 0;
+        uintptr_t end = 0;
+        char dash = 0;
+        std::istringstream header(line);
+        if (header >> std::hex >> begin >> dash >> end && dash == '-') {
+            inside = begin <= address && address < end;
+        } else if (inside && line.rfind("VmFlags:", 0) == 0) {
+            return line.substr(std::string("VmFlags:").size()) + " ";
+        }
+    }
+    return "";
+}
+
+//  Without CONFIG_TRANSPARENT_HUGEPAGE madvise rejects MADV_HUGEPAGE and MADV_NOHUGEPAGE, and the
+//  mappings get neither hg nor nh.
+bool TransparentHugePages() {
+    return std::ifstream("/sys/kernel/mm/transparent_hugepage/enabled").good();
+}
+
+}  // namespace
+
+TEST(AllocatorTest, LargeMatrixIsHugePageAligned) {
+    using s_fast::Matrix;
+    using s_fast::detail_allocator::kHugePageSize;
+
+    Matrix<double> small(10, 10);
+    Matrix<double> large(1024, 1024);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large.Data()) % kHugePageSize, 0);
+    EXPECT_TRUE(small == Matrix<double>(10, 10));
+    EXPECT_EQ(large(1023, 1023), 0);
+}
+
+TEST(AllocatorTest, HugePagesOnAndOff) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::detail_allocator::kHugePageSize;
+    using s_fast::detail_allocator::kHugePageThreshold;
+
+    bool enabled = s_fast::HugePagesEnabled();
+    bool check_flags = TransparentHugePages();
+
+    for (bool huge_pages : {false, true}) {
+        s_fast::SetHugePages(huge_pages);
+        EXPECT_EQ(s_fast::HugePagesEnabled(), huge_pages);
+
+        //  a is above kHugePageThreshold, so it goes through the aligned, madvised path.
+        Matrix<int> a = Random<int>(2100, 520, std::uniform_int_distribution<int>(-3, 3));
+        Matrix<int> b = Random<int>(520, 8, std::uniform_int_distribution<int>(-3, 3));
+        ASSERT_GE(a.Rows() * a.Columns() * sizeof(int), kHugePageThreshold);
+
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(a.Data()) % kHugePageSize, 0);
+        std::string flags = VmFlags(a.Data());
+        if (check_flags && !flags.empty()) {
+            EXPECT_NE(flags.find(huge_pages ? " hg " : " nh "), std::string::npos) << flags;
+            EXPECT_EQ(flags.find(huge_pages ? " nh " : " hg "), std::string::npos) << flags;
+        }
+
+        EXPECT_TRUE(s_fast::SimpleMultiplication(a, b) == s_fast::CacheObliviousMult(a, b));
+    }
+
+    s_fast::SetHugePages(enabled);
+
+    if (!check_flags) {
+        GTEST_SKIP() << "No transparent huge pages in this kernel, VmFlags are not checked";
+    }
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <random>
+
+#include "../src/async_multiplication.h"
+#include "../src/simple_multiplication.h"
+
+TEST(AsyncMultTest, Correctness3x3) {
+    using s_fast::Matrix;
+
+    Matrix<int> a({{1, 6, 3}, {2, -4, 2}, {0, 8, 3}});
+    Matrix<int> b({{-3, 4, 0}, {1, -5, 4}, {2, 0, 0}});
+    Matrix<int> res({{9, -26, 24}, {-6, 28, -16}, {14, -40, 32}});
+
+    std::future<Matrix<int>> return_val = s_fast::MultiplyAsync(a, b);
+
+    EXPECT_TRUE(res == return_val.get());
+}
+
+TEST(AsyncMultTest, PipelinedChain) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimpleMultiplication;
+
+    s_fast::ThreadPool pool(3);
+
+    Matrix<int> a = Random<int>(200, 30, std::uniform_int_distribution<int>(-2, 2));
+    Matrix<int> b = Random<int>(30, 45, std::uniform_int_distribution<int>(-2, 2));
+    Matrix<int> c = Random<int>(45, 17, std::uniform_int_distribution<int>(-2, 2));
+    Matrix<int> d = Random<int>(17, 1, std::uniform_int_distribution<int>(-2, 2));
+
+    auto abc = s_fast::MultiplyAsync(pool, a, b, c);
+    auto abcd = s_fast::MultiplyAsync(pool, a, b, c, d);
+
+    Matrix<int> expected = SimpleMultiplication(SimpleMultiplication(a, b), c);
+    EXPECT_TRUE(expected == abc.get());
+    EXPECT_TRUE(SimpleMultiplication(expected, d) == abcd.get());
+}
+
+TEST(AsyncMultTest, EmptyMatrix) {
+    using s_fast::Matrix;
+
+    Matrix<int> a(0, 3);
+    Matrix<int> b(3, 4);
+
+    Matrix<int> result = s_fast::MultiplyAsync(a, b).get();
+
+    EXPECT_EQ(result.Rows(), 0);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/block_sparse_matrix.h"
+#include "../src/simple_multiplication.h"
+
+namespace {
+
+using s_fast::Matrix;
+
+//  Random matrix whose kTileSize blocks are zero with the given probability.
+Matrix<int> RandomBlocks(int64_t rows, int64_t columns, double empty, uint32_t seed) {
+    constexpr int64_t kTileSize = s_fast::BlockSparseMatrix<int>::kTileSize;
+
+    std::mt19937 generator(seed);
+    std::bernoulli_distribution is_empty(empty);
+    Matrix<int> matrix =
+        s_fast::Random<int>(rows, columns, std::uniform_int_distribution<int>(-3, 3), seed);
+
+    for (int64_t tile_row = 0; tile_row * kTileSize < rows; ++tile_row) {
+        for (int64_t tile_column = 0; tile_column * kTileSize < columns; ++tile_column) {
+            if (!is_empty(generator)) {
+                continue;
+            }
+            for (int64_t i = tile_row * kTileSize; i < std::min(rows, (tile_row + 1) * kTileSize);
+                 ++i) {
+                for (int64_t j = tile_column * kTileSize;
+                     j < std::min(columns, (tile_column + 1) * kTileSize); ++j) {
+                    matrix(i, j) = 0;
+                }
+            }
+        }
+    }
+
+    return matrix;
+}
+
+}  // namespace
+
+TEST(BlockSparseTest, Occupancy) {
+    using s_fast::BlockSparseMatrix;
+
+    Matrix<int> a(100, 70);
+    a(5, 40) = 1;
+    a(99, 0) = 2;
+
+    BlockSparseMatrix<int> sparse(a);
+
+    EXPECT_EQ(sparse.TilesPerSide(), 4);
+    EXPECT_EQ(sparse.OccupiedTiles(), 2);
+    EXPECT_TRUE(sparse.TileOccupied(0, 1));
+    EXPECT_TRUE(sparse.TileOccupied(3, 0));
+    EXPECT_FALSE(sparse.TileOccupied(0, 0));
+    EXPECT_TRUE(a == s_fast::ToRowMajor(sparse));
+
+    sparse(64, 64) = 3;
+    EXPECT_TRUE(sparse.TileOccupied(2, 2));
+    EXPECT_EQ(sparse.OccupiedTiles(), 3);
+}
+
+TEST(BlockSparseTest, StressTest) {
+    using s_fast::BlockSparseMatrix;
+
+    for (double empty : {0., 0.3, 0.7, 1.}) {
+        Matrix<int> a = RandomBlocks(300, 270, empty, 1);
+        Matrix<int> b = RandomBlocks(270, 290, empty, 2);
+        Matrix<int> expected = s_fast::SimpleMultiplication(a, b);
+
+        auto tiles = s_fast::MortonTilesPerSide(a, b);
+        BlockSparseMatrix<int> a_sparse(a, tiles);
+        BlockSparseMatrix<int> b_sparse(b, tiles);
+
+        EXPECT_TRUE(expected == s_fast::ToRowMajor(s_fast::Strassen(a_sparse, b_sparse)));
+        EXPECT_TRUE(expected ==
+                    s_fast::ToRowMajor(s_fast::CacheObliviousMult(a_sparse, b_sparse)));
+    }
+}
+
+TEST(BlockSparseTest, ResultMarksOnlyReachedTiles) {
+    using s_fast::BlockSparseMatrix;
+
+    //  Block diagonal operands give a block diagonal product.
+    Matrix<int> a(128, 128);
+    for (int64_t i = 0; i < 128; ++i) {
+        for (int64_t j = i / 32 * 32; j < (i / 32 + 1) * 32; ++j) {
+            a(i, j) = 1;
+        }
+    }
+
+    BlockSparseMatrix<int> sparse(a);
+    BlockSparseMatrix<int> product = s_fast::Strassen(sparse, sparse);
+
+    EXPECT_EQ(product.OccupiedTiles(), 4);
+    EXPECT_TRUE(s_fast::SimpleMultiplication(a, a) == s_fast::ToRowMajor(product));
+}
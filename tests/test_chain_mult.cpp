@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/chain_multiplication.h"
+#include "../src/simple_multiplication.h"
+
+TEST(ChainMultTest, PlanOptimalOrder) {
+    // Textbook example: 10x30, 30x5, 5x60 is cheapest as (M0 M1) M2.
+    s_fast::ChainPlan plan = s_fast::PlanChain({10, 30, 5, 60});
+
+    EXPECT_EQ(plan.cost, 4500);
+    EXPECT_EQ(plan.ToString(), "((M0 M1) M2)");
+    EXPECT_EQ(plan.steps.size(), 2);
+
+    s_fast::ChainPlan skinny = s_fast::PlanChain({40, 20, 30, 10, 30});
+    EXPECT_EQ(skinny.cost, 26000);
+    EXPECT_EQ(skinny.ToString(), "((M0 (M1 M2)) M3)");
+}
+
+TEST(ChainMultTest, PickEngine) {
+    s_fast::ChainPlan plan = s_fast::PlanChain({512, 512, 512, 4});
+
+    EXPECT_EQ(plan.ToString(), "(M0 (M1 M2))");
+    for (const auto& step : plan.steps) {
+        EXPECT_EQ(step.engine, s_fast::ChainEngine::kSimd);
+    }
+
+    s_fast::ChainPlan square = s_fast::PlanChain({300, 400, 300});
+    EXPECT_EQ(square.steps.front().engine, s_fast::ChainEngine::kStrassen);
+}
+
+TEST(ChainMultTest, StressTest) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimpleMultiplication;
+
+    Matrix<int> a = Random<int>(20, 3, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> b = Random<int>(3, 25, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> c = Random<int>(25, 4, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> d = Random<int>(4, 30, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> e = Random<int>(30, 2, std::uniform_int_distribution<int>(-3, 3));
+
+    Matrix<int> expected = SimpleMultiplication(
+        SimpleMultiplication(SimpleMultiplication(SimpleMultiplication(a, b), c), d), e);
+
+    EXPECT_TRUE(expected == s_fast::MultiplyChain(a, b, c, d, e));
+    EXPECT_TRUE(a == s_fast::MultiplyChain(a));
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/complex_multiplication.h"
+#include "../src/simple_multiplication.h"
+#include "../src/strassen.h"
+
+namespace {
+
+using Complex = std::complex<double>;
+
+//  Integer parts keep every engine exact, so results can be compared with ==.
+s_fast::Matrix<Complex> RandomComplex(int64_t rows, int64_t columns, uint64_t seed) {
+    auto real = s_fast::Random<double>(rows, columns, std::uniform_int_distribution<int>(-5, 5),
+                                       seed);
+    auto imag = s_fast::Random<double>(rows, columns, std::uniform_int_distribution<int>(-5, 5),
+                                       seed + 1);
+    return s_fast::ToInterleaved(s_fast::SplitComplex<double>{real, imag});
+}
+
+}  // namespace
+
+TEST(ComplexMultTest, Correctness2x2) {
+    using s_fast::Matrix;
+
+    Matrix<Complex> a({{{1, 1}, {0, 2}}, {{3, 0}, {-1, -1}}});
+    Matrix<Complex> b({{{2, 0}, {0, 1}}, {{1, -1}, {4, 0}}});
+    Matrix<Complex> res({{{4, 4}, {-1, 9}}, {{4, 0}, {-4, -1}}});
+
+    EXPECT_TRUE(res == s_fast::ComplexMultiplication(a, b));
+    EXPECT_TRUE(res == s_fast::ComplexMultiplication(a, b, s_fast::ComplexAlgorithm::kThreeM));
+}
+
+TEST(ComplexMultTest, StressTest) {
+    using s_fast::ComplexAlgorithm;
+    using s_fast::Matrix;
+
+    s_fast::ThreadPool pool(2);
+
+    Matrix<Complex> a = RandomComplex(97, 45, 1);
+    Matrix<Complex> b = RandomComplex(45, 71, 3);
+    Matrix<Complex> expected = s_fast::SimpleMultiplication(a, b);
+
+    for (auto algorithm : {ComplexAlgorithm::kFourM, ComplexAlgorithm::kThreeM}) {
+        EXPECT_TRUE(expected == s_fast::ComplexMultiplication(a, b, algorithm));
+        EXPECT_TRUE(expected == s_fast::ComplexMultiplication(a, b, algorithm, &pool));
+    }
+
+    EXPECT_TRUE(expected == s_fast::SimdMultiplication(a, b));
+    EXPECT_TRUE(expected == s_fast::Strassen(a, b));
+}
+
+TEST(ComplexMultTest, ThreeMOnRealEngine) {
+    using s_fast::Matrix;
+
+    auto a = s_fast::ToSplit(RandomComplex(40, 33, 5));
+    auto b = s_fast::ToSplit(RandomComplex(33, 40, 7));
+
+    auto expected = s_fast::ComplexMultiplication(a, b);
+    auto strassen = [](const Matrix<double>& x, const Matrix<double>& y) {
+        return s_fast::Strassen(x, y);
+    };
+    auto result = s_fast::ComplexMultiplication3M(a, b, strassen);
+
+    EXPECT_TRUE(expected.real == result.real);
+    EXPECT_TRUE(expected.imag == result.imag);
+}
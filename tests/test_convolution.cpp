@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/convolution.h"
+
+namespace {
+
+template <class T>
+s_fast::Tensor<T> RandomTensor(int64_t batch, int64_t channels, int64_t height, int64_t width,
+                               uint64_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> distribution(-5, 5);
+
+    s_fast::Tensor<T> tensor(batch, channels, height, width);
+    for (int64_t i = 0; i < batch; ++i) {
+        for (int64_t c = 0; c < channels; ++c) {
+            for (int64_t y = 0; y < height; ++y) {
+                for (int64_t x = 0; x < width; ++x) {
+                    tensor(i, c, y, x) = distribution(random);
+                }
+            }
+        }
+    }
+    return tensor;
+}
+
+template <class T>
+s_fast::Tensor<T> DirectConv2D(const s_fast::Tensor<T>& input, const s_fast::Tensor<T>& filters,
+                               s_fast::Conv2DParams params) {
+    int64_t height = (input.Height() + 2 * params.padding_rows - filters.Height()) /
+                         params.stride_rows +
+                     1;
+    int64_t width = (input.Width() + 2 * params.padding_columns - filters.Width()) /
+                        params.stride_columns +
+                    1;
+
+    s_fast::Tensor<T> output(input.Batch(), filters.Batch(), height, width);
+    for (int64_t i = 0; i < input.Batch(); ++i) {
+        for (int64_t f = 0; f < filters.Batch(); ++f) {
+            for (int64_t y = 0; y < height; ++y) {
+                for (int64_t x = 0; x < width; ++x) {
+                    T sum = 0;
+                    for (int64_t c = 0; c < input.Channels(); ++c) {
+                        for (int64_t ky = 0; ky < filters.Height(); ++ky) {
+                            for (int64_t kx = 0; kx < filters.Width(); ++kx) {
+                                int64_t row = y * params.stride_rows - params.padding_rows + ky;
+                                int64_t column =
+                                    x * params.stride_columns - params.padding_columns + kx;
+                                if (0 <= row && row < input.Height() && 0 <= column &&
+                                    column < input.Width()) {
+                                    sum += input(i, c, row, column) * filters(f, c, ky, kx);
+                                }
+                            }
+                        }
+                    }
+                    output(i, f, y, x) = sum;
+                }
+            }
+        }
+    }
+    return output;
+}
+
+}  // namespace
+
+TEST(ConvolutionTest, Correctness3x3) {
+    using s_fast::Tensor;
+
+    Tensor<int> input(1, 1, 3, 3);
+    Tensor<int> filter(1, 1, 2, 2);
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 3; ++x) {
+            input(0, 0, y, x) = 3 * y + x + 1;
+        }
+    }
+    filter(0, 0, 0, 0) = 1;
+    filter(0, 0, 1, 1) = -1;
+
+    Tensor<int> output = s_fast::Conv2D(input, filter);
+    ASSERT_EQ(output.Height(), 2);
+    ASSERT_EQ(output.Width(), 2);
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 2; ++x) {
+            EXPECT_EQ(output(0, 0, y, x), -4);
+        }
+    }
+}
+
+TEST(ConvolutionTest, StressTest) {
+    using s_fast::Conv2DParams;
+    using s_fast::Tensor;
+
+    s_fast::ThreadPool pool(3);
+
+    Tensor<double> input = RandomTensor<double>(3, 5, 23, 17, 1);
+    for (Conv2DParams params :
+         {Conv2DParams{}, Conv2DParams{2, 1, 1, 0}, Conv2DParams{3, 2, 2, 2}}) {
+        for (int64_t filters : {1, 6}) {
+            Tensor<double> weights = RandomTensor<double>(filters, 5, 3, 4, 2);
+            Tensor<double> expected = DirectConv2D(input, weights, params);
+
+            EXPECT_TRUE(expected == s_fast::Conv2D(input, weights, params));
+            EXPECT_TRUE(expected == s_fast::Conv2D(input, weights, params, &pool));
+        }
+    }
+
+    Tensor<int> image = RandomTensor<int>(2, 3, 40, 40, 3);
+    Tensor<int> kernel = RandomTensor<int>(9, 3, 5, 5, 4);
+    Conv2DParams same{1, 1, 2, 2};
+    EXPECT_TRUE(DirectConv2D(image, kernel, same) == s_fast::Conv2D(image, kernel, same, &pool));
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/epilogue.h"
+#include "../src/executor.h"
+#include "../src/packed_matrix.h"
+#include "../src/simd_multiplication.h"
+#include "../src/simple_multiplication.h"
+#include "../src/strassen.h"
+
+namespace {
+
+using s_fast::Matrix;
+
+//  The same epilogue applied as separate passes over a finished product.
+template <class T, class Function>
+Matrix<T> ApplyEach(Matrix<T> matrix, Function function) {
+    for (int64_t i = 0; i < matrix.Rows(); ++i) {
+        for (int64_t j = 0; j < matrix.Columns(); ++j) {
+            matrix(i, j) = function(matrix(i, j), i, j);
+        }
+    }
+    return matrix;
+}
+
+//  Checks every engine that takes an epilogue against a plain product followed by `expected`.
+template <class T, class Op, class Function>
+void CheckEngines(const Matrix<T>& a, const Matrix<T>& b, const s_fast::Epilogue<Op>& epilogue,
+                  Function expected) {
+    Matrix<T> reference = ApplyEach(s_fast::SimpleMultiplication(a, b), expected);
+    s_fast::ThreadPool pool(3);
+    s_fast::PackedMatrix<T> packed(b);
+
+    EXPECT_TRUE(s_fast::SimdMultiplication(a, b, epilogue) == reference);
+    EXPECT_TRUE(s_fast::SimdMultiplication(a, b, epilogue, &pool) == reference);
+    EXPECT_TRUE(s_fast::SimdMultiplication(a, packed, epilogue) == reference);
+    EXPECT_TRUE(s_fast::SimdMultiplication(a, packed, epilogue, &pool) == reference);
+    EXPECT_TRUE(s_fast::Strassen(a, b, epilogue) == reference);
+    EXPECT_TRUE(s_fast::Strassen(a, b, epilogue, &pool) == reference);
+}
+
+}  // namespace
+
+TEST(EpilogueTest, Predefined) {
+    Matrix<int> a = s_fast::Random<int>(67, 45, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> b = s_fast::Random<int>(45, 77, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> c = s_fast::Random<int>(67, 77, std::uniform_int_distribution<int>(-5, 5));
+
+    std::vector<int> column_bias(77);
+    std::vector<int> row_bias(67);
+    for (size_t i = 0; i < column_bias.size(); ++i) {
+        column_bias[i] = static_cast<int>(i % 7) - 3;
+    }
+    for (size_t i = 0; i < row_bias.size(); ++i) {
+        row_bias[i] = static_cast<int>(i % 5) - 2;
+    }
+
+    CheckEngines(a, b, s_fast::Scale(3), [](int x, int64_t, int64_t) { return 3 * x; });
+    CheckEngines(a, b, s_fast::BiasColumns(column_bias),
+                 [&](int x, int64_t, int64_t j) { return x + column_bias[j]; });
+    CheckEngines(a, b, s_fast::BiasRows(row_bias),
+                 [&](int x, int64_t i, int64_t) { return x + row_bias[i]; });
+    CheckEngines(a, b, s_fast::AddMatrix(c, 2),
+                 [&](int x, int64_t i, int64_t j) { return x + 2 * c(i, j); });
+    CheckEngines(a, b, s_fast::Relu(), [](int x, int64_t, int64_t) { return std::max(x, 0); });
+    CheckEngines(a, b, s_fast::Clamp(-10, 20),
+                 [](int x, int64_t, int64_t) { return std::clamp(x, -10, 20); });
+    CheckEngines(a, b, s_fast::Elementwise([](int x) { return x * x; }),
+                 [](int x, int64_t, int64_t) { return x * x; });
+}
+
+TEST(EpilogueTest, ComposedInOrder) {
+    Matrix<double> a = s_fast::Random<double>(130, 70, std::uniform_int_distribution<int>(-4, 4));
+    Matrix<double> b = s_fast::Random<double>(70, 90, std::uniform_int_distribution<int>(-4, 4));
+    std::vector<double> bias(90, -5);
+
+    auto epilogue = s_fast::BiasColumns(bias).Then(s_fast::Scale(0.5)).Then(s_fast::Relu());
+
+    CheckEngines(a, b, epilogue,
+                 [](double x, int64_t, int64_t) { return std::max((x - 5) * 0.5, 0.); });
+}
+
+TEST(EpilogueTest, CustomFunctorSeesPositions) {
+    Matrix<int64_t> a = s_fast::Random<int64_t>(33, 20, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int64_t> b = s_fast::Random<int64_t>(20, 41, std::uniform_int_distribution<int>(-3, 3));
+
+    s_fast::Epilogue position([](int64_t* values, int64_t row, int64_t column, int64_t count) {
+        for (int64_t i = 0; i < count; ++i) {
+            values[i] += 1000 * row + column + i;
+        }
+    });
+
+    CheckEngines(a, b, position,
+                 [](int64_t x, int64_t i, int64_t j) { return x + 1000 * i + j; });
+}
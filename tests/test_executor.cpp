@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/chain_multiplication.h"
+#include "../src/executor.h"
+#include "../src/simd_multiplication.h"
+#include "../src/simple_multiplication.h"
+#include "../src/strassen.h"
+#include "../src/symmetric_multiplication.h"
+
+TEST(ExecutorTest, SerialExecutorRunsInline) {
+    s_fast::SerialExecutor executor;
+    std::thread::id caller = std::this_thread::get_id();
+    std::vector<int64_t> chunks;
+
+    s_fast::ParallelFor(executor, 100, 30, [&](int64_t begin, int64_t end) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        chunks.push_back(end - begin);
+    });
+
+    EXPECT_EQ(executor.Concurrency(), 1u);
+    EXPECT_EQ(chunks, std::vector<int64_t>({30, 30, 30, 10}));
+}
+
+TEST(ExecutorTest, NullExecutorIsOneChunk) {
+    int calls = 0;
+
+    s_fast::ParallelFor(static_cast<s_fast::Executor*>(nullptr), 100, 30,
+                        [&](int64_t begin, int64_t end) {
+                            EXPECT_EQ(begin, 0);
+                            EXPECT_EQ(end, 100);
+                            ++calls;
+                        });
+
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(ExecutorTest, LimitedExecutorCapsTasksInFlight) {
+    s_fast::ThreadPool pool(4);
+    s_fast::LimitedExecutor limited(pool, 2);
+
+    std::atomic<int> in_flight = 0;
+    std::atomic<int> peak = 0;
+    std::atomic<int64_t> sum = 0;
+
+    s_fast::ParallelFor(limited, 1000, 10, [&](int64_t begin, int64_t end) {
+        int now = ++in_flight;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        for (int64_t i = begin; i < end; ++i) {
+            sum += i;
+        }
+        --in_flight;
+    });
+
+    EXPECT_EQ(limited.Concurrency(), 2u);
+    EXPECT_LE(peak.load(), 2);
+    EXPECT_EQ(sum.load(), 999 * 1000 / 2);
+}
+
+TEST(ExecutorTest, EnginesAgreeOnEveryExecutor) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    std::uniform_int_distribution<int64_t> distribution(-10, 10);
+    Matrix<int64_t> a = Random<int64_t>(301, 157, distribution);
+    Matrix<int64_t> b = Random<int64_t>(157, 203, distribution);
+    Matrix<int64_t> expected = s_fast::SimpleMultiplication(a, b);
+
+    s_fast::ThreadPool pool(3);
+    s_fast::LimitedExecutor limited(pool, 2);
+    s_fast::SerialExecutor serial;
+    s_fast::MatrixChain<int64_t> chain = {std::cref(a), std::cref(b)};
+
+    for (s_fast::Executor* executor : std::vector<s_fast::Executor*>{&pool, &limited, &serial}) {
+        EXPECT_TRUE(s_fast::SimpleMultiplication(a, b, executor) == expected);
+        EXPECT_TRUE(s_fast::SimdMultiplication(a, b, executor) == expected);
+        EXPECT_TRUE(s_fast::Strassen(a, b, executor) == expected);
+        EXPECT_TRUE(s_fast::CacheObliviousMult(a, b, executor) == expected);
+        EXPECT_TRUE(s_fast::MultiplyChain(chain, executor) == expected);
+
+        EXPECT_TRUE(s_fast::Syrk(a, s_fast::Gram::kRows, s_fast::Triangle::kLower, executor) ==
+                    s_fast::Syrk(a));
+        EXPECT_TRUE(s_fast::Syrk(a, s_fast::Gram::kColumns, s_fast::Triangle::kUpper, executor) ==
+                    s_fast::Syrk(a, s_fast::Gram::kColumns, s_fast::Triangle::kUpper));
+    }
+}
+
+TEST(ExecutorTest, StrassenOnWidePool) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    //  More threads than the seven top level products, and a skinny shape that goes to row slabs.
+    s_fast::ThreadPool pool(16);
+    std::uniform_int_distribution<int64_t> distribution(-10, 10);
+
+    Matrix<int64_t> a = Random<int64_t>(257, 129, distribution);
+    Matrix<int64_t> b = Random<int64_t>(129, 255, distribution);
+    EXPECT_TRUE(s_fast::Strassen(a, b, &pool) == s_fast::SimpleMultiplication(a, b));
+
+    Matrix<int64_t> tall = Random<int64_t>(3000, 8, distribution);
+    Matrix<int64_t> small = Random<int64_t>(8, 8, distribution);
+    EXPECT_TRUE(s_fast::Strassen(tall, small, &pool) == s_fast::SimpleMultiplication(tall, small));
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/executor.h"
+#include "../src/incremental_product.h"
+#include "../src/simple_multiplication.h"
+
+namespace {
+
+using s_fast::Matrix;
+
+Matrix<int64_t> RandomMatrix(int64_t rows, int64_t columns, uint32_t seed) {
+    return s_fast::Random<int64_t>(rows, columns, std::uniform_int_distribution<int64_t>(-5, 5),
+                                   seed);
+}
+
+}  // namespace
+
+TEST(IncrementalProductTest, RowAndColumnUpdates) {
+    s_fast::IncrementalProduct<int64_t> product(RandomMatrix(130, 70, 1),
+                                                RandomMatrix(70, 90, 2));
+
+    EXPECT_TRUE(product.Product() == s_fast::SimpleMultiplication(product.Lhs(), product.Rhs()));
+
+    product.SetLhsRows({3, 129, 40}, RandomMatrix(3, 70, 3));
+    EXPECT_TRUE(product.Product() == s_fast::SimpleMultiplication(product.Lhs(), product.Rhs()));
+
+    product.SetRhsColumns({0, 89}, RandomMatrix(70, 2, 4));
+    EXPECT_TRUE(product.Product() == s_fast::SimpleMultiplication(product.Lhs(), product.Rhs()));
+
+    Matrix<int64_t> rows = RandomMatrix(1, 70, 5);
+    product.SetLhsRows({7}, rows);
+    for (int64_t column = 0; column < 70; ++column) {
+        EXPECT_EQ(product.Lhs()(7, column), rows(0, column));
+    }
+}
+
+TEST(IncrementalProductTest, LowRankUpdates) {
+    s_fast::ThreadPool pool(2);
+    Matrix<int64_t> lhs = RandomMatrix(100, 80, 6);
+    Matrix<int64_t> rhs = RandomMatrix(80, 60, 7);
+    s_fast::IncrementalProduct<int64_t> product(lhs, rhs, &pool);
+
+    Matrix<int64_t> u = RandomMatrix(100, 3, 8);
+    Matrix<int64_t> v = RandomMatrix(3, 80, 9);
+    product.UpdateLhs(u, v);
+    lhs += s_fast::SimpleMultiplication(u, v);
+
+    EXPECT_TRUE(product.Lhs() == lhs);
+    EXPECT_TRUE(product.Product() == s_fast::SimpleMultiplication(lhs, rhs));
+
+    Matrix<int64_t> x = RandomMatrix(80, 2, 10);
+    Matrix<int64_t> y = RandomMatrix(2, 60, 11);
+    product.UpdateRhs(x, y);
+    rhs += s_fast::SimpleMultiplication(x, y);
+
+    EXPECT_TRUE(product.Rhs() == rhs);
+    EXPECT_TRUE(product.Product() == s_fast::SimpleMultiplication(lhs, rhs));
+
+    product.Recompute();
+    EXPECT_TRUE(product.Product() == s_fast::SimpleMultiplication(lhs, rhs));
+}
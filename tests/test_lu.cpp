@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+#include "../src/executor.h"
+#include "../src/lu.h"
+#include "../src/simple_multiplication.h"
+
+namespace {
+
+using s_fast::Matrix;
+
+double MaxDifference(const Matrix<double>& lhs, const Matrix<double>& rhs) {
+    using Index = Matrix<double>::Index;
+
+    double difference = 0;
+    for (Index i = 0; i < lhs.Rows(); ++i) {
+        for (Index j = 0; j < lhs.Columns(); ++j) {
+            difference = std::max(difference, std::abs(lhs(i, j) - rhs(i, j)));
+        }
+    }
+    return difference;
+}
+
+Matrix<double> Identity(int64_t size) {
+    Matrix<double> identity(size, size);
+    for (int64_t i = 0; i < size; ++i) {
+        identity(i, i) = 1;
+    }
+    return identity;
+}
+
+Matrix<double> RandomMatrix(int64_t rows, int64_t columns, uint32_t seed) {
+    return s_fast::Random<double>(rows, columns, std::uniform_real_distribution<double>(-1, 1),
+                                  seed);
+}
+
+}  // namespace
+
+TEST(LUTest, FactorsReproduceMatrix) {
+    using Index = Matrix<double>::Index;
+
+    Matrix<double> a = RandomMatrix(150, 150, 1);
+    a(0, 0) = 0;
+    s_fast::LUDecomposition<double> lu(a);
+
+    Matrix<double> l(a.Rows(), a.Rows());
+    Matrix<double> u(a.Rows(), a.Rows());
+    for (Index i = 0; i < a.Rows(); ++i) {
+        for (Index j = 0; j < a.Rows(); ++j) {
+            (j < i ? l : u)(i, j) = lu.Factors()(i, j);
+        }
+        l(i, i) = 1;
+    }
+
+    Matrix<double> permuted = a;
+    for (Index i = 0; i < a.Rows(); ++i) {
+        ASSERT_GE(lu.Pivots()[i], i);
+        std::swap_ranges(&permuted(i, 0), &permuted(i, 0) + a.Rows(),
+                         &permuted(lu.Pivots()[i], 0));
+    }
+
+    EXPECT_FALSE(lu.Singular());
+    EXPECT_LT(MaxDifference(permuted, s_fast::SimpleMultiplication(l, u)), 1e-10);
+}
+
+TEST(LUTest, Solve) {
+    Matrix<double> a = RandomMatrix(301, 301, 2);
+    Matrix<double> b = RandomMatrix(301, 7, 3);
+
+    Matrix<double> x = s_fast::LUDecomposition<double>(a).Solve(b);
+
+    EXPECT_LT(MaxDifference(s_fast::SimpleMultiplication(a, x), b), 1e-9);
+}
+
+TEST(LUTest, Determinant) {
+    Matrix<double> a(3, 3);
+    a(0, 1) = 2;
+    a(1, 0) = 3;
+    a(2, 2) = 5;
+
+    EXPECT_DOUBLE_EQ(s_fast::LUDecomposition<double>(a).Determinant(), -30);
+}
+
+TEST(LUTest, Singular) {
+    Matrix<double> a = RandomMatrix(100, 100, 4);
+    for (int64_t i = 0; i < a.Rows(); ++i) {
+        a(i, 70) = 0;
+    }
+
+    s_fast::LUDecomposition<double> lu(a);
+
+    EXPECT_TRUE(lu.Singular());
+    EXPECT_EQ(lu.Determinant(), 0);
+    EXPECT_THROW(lu.Solve(RandomMatrix(100, 1, 5)), std::runtime_error);
+    EXPECT_THROW(s_fast::Inverse(Matrix<double>(5, 5)), std::runtime_error);
+}
+
+TEST(LUTest, SolveTriangular) {
+    using s_fast::Diagonal;
+    using s_fast::Triangle;
+
+    //  Small off-diagonal entries keep the unit triangles well conditioned.
+    Matrix<double> t = RandomMatrix(200, 200, 5);
+    t *= 0.01;
+    for (int64_t i = 0; i < t.Rows(); ++i) {
+        t(i, i) += 1;
+    }
+    Matrix<double> b = RandomMatrix(200, 33, 6);
+
+    for (Triangle triangle : {Triangle::kLower, Triangle::kUpper}) {
+        for (Diagonal diagonal : {Diagonal::kNonUnit, Diagonal::kUnit}) {
+            Matrix<double> kept(t.Rows(), t.Rows());
+            for (int64_t i = 0; i < t.Rows(); ++i) {
+                for (int64_t j = 0; j < t.Rows(); ++j) {
+                    bool inside = triangle == Triangle::kLower ? j <= i : j >= i;
+                    bool unit = i == j && diagonal == Diagonal::kUnit;
+                    kept(i, j) = !inside ? 0 : (unit ? 1 : t(i, j));
+                }
+            }
+
+            Matrix<double> x = s_fast::SolveTriangular(t, triangle, b, diagonal);
+            EXPECT_LT(MaxDifference(s_fast::SimpleMultiplication(kept, x), b), 1e-9);
+        }
+    }
+}
+
+TEST(LUTest, InverseWithExecutor) {
+    Matrix<double> a = RandomMatrix(600, 600, 7);
+    s_fast::ThreadPool pool(2);
+
+    Matrix<double> inverse = s_fast::Inverse(a, &pool);
+
+    EXPECT_LT(MaxDifference(s_fast::SimpleMultiplication(a, inverse), Identity(600)), 1e-8);
+}
@@ -83,3 +83,48 @@ TEST(MatrixCorrection, Random) {
         }
     }
 }
+
+TEST(MatrixCorrection, SmallBuffer) {
+    using s_fast::Matrix;
+    using s_fast::MatrixStorage;
+
+    Matrix<double> small({{1, 2}, {3, 4}});
+    Matrix<double> large(20, 20);
+    large(19, 19) = 5;
+
+    Matrix<double> small_copy = small;
+    Matrix<double> large_copy = large;
+    EXPECT_TRUE(small_copy == small);
+    EXPECT_TRUE(large_copy == large);
+
+    Matrix<double> small_moved = std::move(small_copy);
+    Matrix<double> large_moved = std::move(large_copy);
+    EXPECT_TRUE(small_moved == small);
+    EXPECT_TRUE(large_moved == large);
+    EXPECT_EQ(small_copy.Rows(), 0);
+    EXPECT_EQ(large_copy.Rows(), 0);
+
+    small_moved = large;
+    large_moved = small;
+    EXPECT_TRUE(small_moved == large);
+    EXPECT_TRUE(large_moved == small);
+
+    MatrixStorage<std::vector<int>> vectors;
+    vectors.Assign(3, std::vector<int>(40, 7));
+    MatrixStorage<std::vector<int>> moved = std::move(vectors);
+    EXPECT_EQ(moved.Size(), 3);
+    EXPECT_TRUE(moved.IsInline());
+    EXPECT_EQ(moved[2][39], 7);
+}
+
+TEST(MatrixCorrection, Uninitialized) {
+    using s_fast::Matrix;
+
+    Matrix<int> a(3, 5, s_fast::kUninitialized);
+    EXPECT_EQ(a.Rows(), 3);
+    EXPECT_EQ(a.Columns(), 5);
+
+    a.Reset(40, 40, s_fast::kUninitialized);
+    a.Reset(2, 2);
+    EXPECT_TRUE(a == Matrix<int>(2, 2));
+}
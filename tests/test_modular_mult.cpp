@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/modular.h"
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/simple_multiplication.h"
+#include "../src/strassen.h"
+
+namespace {
+
+class ModularMultTest : public ::testing::Test {
+protected:
+    using Index = s_fast::Matrix<int>::Index;
+
+    static constexpr uint32_t kPrime = 2147483647;
+
+    using Element = s_fast::ModInt<kPrime>;
+
+    static size_t ItersCount() {
+        return 5;
+    }
+
+    static Index RowsL() {
+        return 40;
+    }
+
+    static Index ColumnsL() {
+        return 37;
+    }
+
+    static Index RowsR() {
+        return 35;
+    }
+
+    static s_fast::Matrix<Element> RandomMatrix(Index rows, Index columns, uint64_t seed) {
+        return s_fast::Random<Element>(
+            rows, columns, std::uniform_int_distribution<int64_t>(0, kPrime - 1), seed);
+    }
+};
+
+}  // namespace
+
+TEST_F(ModularMultTest, Arithmetic) {
+    using s_fast::ModInt;
+
+    EXPECT_EQ(ModInt<7>(-1).Value(), 6);
+    EXPECT_EQ(ModInt<7>(15).Value(), 1);
+    EXPECT_EQ((ModInt<7>(5) + ModInt<7>(4)).Value(), 2);
+    EXPECT_EQ((ModInt<7>(2) - ModInt<7>(5)).Value(), 4);
+    EXPECT_EQ((ModInt<7>(3) * ModInt<7>(5)).Value(), 1);
+    EXPECT_EQ((-ModInt<7>(3)).Value(), 4);
+    EXPECT_EQ((Element(kPrime - 1) * Element(kPrime - 1)).Value(), 1);
+}
+
+TEST_F(ModularMultTest, Correctness3x3) {
+    using s_fast::Matrix;
+
+    Matrix<s_fast::ModInt<7>> a({{1, 6, 3}, {2, -4, 2}, {0, 8, 3}});
+    Matrix<s_fast::ModInt<7>> b({{-3, 4, 0}, {1, -5, 4}, {2, 0, 0}});
+    Matrix<s_fast::ModInt<7>> res({{9, -26, 24}, {-6, 28, -16}, {14, -40, 32}});
+
+    EXPECT_TRUE(res == s_fast::SimdMultiplication(a, b));
+}
+
+TEST_F(ModularMultTest, StressTest) {
+    using s_fast::Matrix;
+
+    for (size_t iter = 0; iter < ItersCount(); ++iter) {
+        Matrix<Element> a = RandomMatrix(RowsL(), ColumnsL(), 2 * iter);
+        Matrix<Element> b = RandomMatrix(ColumnsL(), RowsR(), 2 * iter + 1);
+
+        Matrix<Element> expected = s_fast::SimpleMultiplication(a, b);
+
+        EXPECT_TRUE(expected == s_fast::SimdMultiplication(a, b));
+        EXPECT_TRUE(expected == s_fast::Strassen(a, b));
+        EXPECT_TRUE(expected == s_fast::CacheObliviousMult(a, b));
+    }
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/morton_matrix.h"
+#include "../src/simple_multiplication.h"
+#include "../src/strassen.h"
+
+TEST(MortonMatrixTest, Conversion) {
+    using s_fast::Matrix;
+    using s_fast::MortonMatrix;
+    using Index = Matrix<int>::Index;
+
+    Matrix<int> a = s_fast::Random<int>(70, 45, std::uniform_int_distribution<int>(-100, 100));
+    MortonMatrix<int> morton = s_fast::ToMorton(a);
+
+    EXPECT_EQ(morton.Rows(), 70);
+    EXPECT_EQ(morton.Columns(), 45);
+    EXPECT_EQ(morton.TilesPerSide(), 4);
+
+    for (Index i = 0; i < a.Rows(); ++i) {
+        for (Index j = 0; j < a.Columns(); ++j) {
+            EXPECT_EQ(morton(i, j), a(i, j));
+        }
+    }
+
+    EXPECT_TRUE(a == s_fast::ToRowMajor(morton));
+
+    // The second tile in Z order is the right neighbour of the first one.
+    EXPECT_EQ(morton.Data()[MortonMatrix<int>::kTileSize * MortonMatrix<int>::kTileSize],
+              a(0, MortonMatrix<int>::kTileSize));
+}
+
+TEST(MortonMatrixTest, StressTest) {
+    using s_fast::Matrix;
+    using s_fast::MortonMatrix;
+    using s_fast::Random;
+
+    Matrix<int> a = Random<int>(150, 97, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> b = Random<int>(97, 130, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> expected = s_fast::SimpleMultiplication(a, b);
+
+    auto tiles = s_fast::MortonTilesPerSide(a, b);
+    MortonMatrix<int> a_morton = s_fast::ToMorton(a, tiles);
+    MortonMatrix<int> b_morton = s_fast::ToMorton(b, tiles);
+
+    EXPECT_TRUE(expected == s_fast::ToRowMajor(s_fast::CacheObliviousMult(a_morton, b_morton)));
+    EXPECT_TRUE(expected == s_fast::ToRowMajor(s_fast::Strassen(a_morton, b_morton)));
+}
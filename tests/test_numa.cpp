@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/executor.h"
+#include "../src/numa.h"
+#include "../src/simd_multiplication.h"
+#include "../src/simple_multiplication.h"
+
+TEST(NumaTest, ParseList) {
+    using s_fast::detail_numa::ParseList;
+
+    EXPECT_EQ(ParseList("0-3,8,10-11\n"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(ParseList("5"), std::vector<int>({5}));
+    EXPECT_TRUE(ParseList("").empty());
+}
+
+TEST(NumaTest, TopologyIsNotEmpty) {
+    auto nodes = s_fast::detail_numa::NodeCpus();
+
+    ASSERT_FALSE(nodes.empty());
+    EXPECT_GE(s_fast::NumaThreadPool().Nodes(), 1);
+}
+
+TEST(NumaTest, FirstTouchMatrixIsZero) {
+    using s_fast::Matrix;
+
+    s_fast::NumaThreadPool pool({{0}, {0}, {0}});
+    Matrix<double> matrix(157, 31, pool);
+
+    EXPECT_TRUE(matrix == Matrix<double>(157, 31));
+
+    matrix(3, 4) = 1;
+    matrix.Reset(2, 500, pool);
+    EXPECT_TRUE(matrix == Matrix<double>(2, 500));
+}
+
+TEST(NumaTest, StressTest) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    s_fast::NumaThreadPool pool({{0, 1}, {0}});
+
+    Matrix<int> a = Random<int>(300, 45, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> b = Random<int>(45, 70, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> result(1, 1);
+
+    s_fast::SimdMultiplication(a, b, &result, &pool);
+
+    EXPECT_TRUE(s_fast::SimpleMultiplication(a, b) == result);
+}
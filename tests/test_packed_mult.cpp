@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/packed_matrix.h"
+#include "../src/simple_multiplication.h"
+
+TEST(PackedMultTest, Correctness3x3) {
+    using s_fast::Matrix;
+
+    Matrix<int> a({{1, 6, 3}, {2, -4, 2}, {0, 8, 3}});
+    Matrix<int> b({{-3, 4, 0}, {1, -5, 4}, {2, 0, 0}});
+    Matrix<int> res({{9, -26, 24}, {-6, 28, -16}, {14, -40, 32}});
+
+    s_fast::PackedMatrix<int> packed(b);
+
+    EXPECT_TRUE(res == s_fast::SimdMultiplication(a, packed));
+}
+
+TEST(PackedMultTest, StressTest) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    s_fast::ThreadPool pool(3);
+
+    for (int64_t columns : {1, 7, 64, 131}) {
+        Matrix<double> a = Random<double>(203, 57, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<double> b = Random<double>(57, columns, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<double> expected = s_fast::SimpleMultiplication(a, b);
+
+        s_fast::PackedMatrix<double> packed(b);
+        EXPECT_TRUE(expected == s_fast::SimdMultiplication(a, packed));
+
+        Matrix<double> result;
+        s_fast::SimdMultiplication(a, packed, &result, &pool);
+        EXPECT_TRUE(expected == result);
+    }
+}
+
+TEST(PackedMultTest, ConcurrentCallers) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    Matrix<int> b = Random<int>(40, 90, std::uniform_int_distribution<int>(-5, 5));
+    const s_fast::PackedMatrix<int> packed(b);
+
+    std::vector<Matrix<int>> inputs;
+    std::vector<Matrix<int>> outputs(4);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        inputs.push_back(Random<int>(30 + i, 40, std::uniform_int_distribution<int>(-5, 5), i));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        threads.emplace_back(
+            [&, i] { outputs[i] = s_fast::SimdMultiplication(inputs[i], packed); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        EXPECT_TRUE(s_fast::SimpleMultiplication(inputs[i], b) == outputs[i]);
+    }
+}
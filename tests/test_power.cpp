@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/modular.h"
+#include "../src/power.h"
+#include "../src/simple_multiplication.h"
+
+TEST(PowerTest, Fibonacci) {
+    using s_fast::Matrix;
+    using Element = s_fast::ModInt<1000000007>;
+
+    Matrix<int64_t> step({{1, 1}, {1, 0}});
+    EXPECT_EQ(s_fast::Power(step, 50)(0, 1), 12586269025);
+    EXPECT_TRUE(s_fast::Power(step, 0) == Matrix<int64_t>({{1, 0}, {0, 1}}));
+    EXPECT_TRUE(s_fast::Power(step, 1) == step);
+
+    Matrix<Element> modular_step({{1, 1}, {1, 0}});
+    // F(10^18) mod 10^9 + 7.
+    EXPECT_EQ(s_fast::Power(modular_step, 1000000000000000000)(0, 1).Value(), 209783453);
+}
+
+TEST(PowerTest, StressTest) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimpleMultiplication;
+
+    s_fast::ThreadPool pool(3);
+
+    for (int64_t size : {7, 100, 256}) {
+        Matrix<int> a = Random<int>(size, size, std::uniform_int_distribution<int>(0, 1));
+
+        Matrix<int> expected = a;
+        for (uint64_t exponent = 1; exponent <= 3; ++exponent) {
+            EXPECT_TRUE(expected == s_fast::Power(a, exponent));
+            EXPECT_TRUE(expected == s_fast::Power(a, exponent, pool));
+            expected = SimpleMultiplication(expected, a);
+        }
+    }
+}
+
+TEST(PowerTest, ParallelModular) {
+    using s_fast::Matrix;
+    using Element = s_fast::ModInt<998244353>;
+
+    s_fast::ThreadPool pool(2);
+
+    Matrix<Element> a =
+        s_fast::Random<Element>(90, 90, std::uniform_int_distribution<int64_t>(0, 998244352));
+
+    Matrix<Element> expected = a;
+    for (int i = 0; i < 12; ++i) {
+        expected = s_fast::SimpleMultiplication(expected, a);
+    }
+
+    EXPECT_TRUE(expected == s_fast::Power(a, 13));
+    EXPECT_TRUE(expected == s_fast::Power(a, 13, pool));
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/shared_memory_multiplication.h"
+#include "../src/simple_multiplication.h"
+
+TEST(SharedMemoryMultTest, Correctness3x3) {
+    using s_fast::Matrix;
+
+    Matrix<int> a({{1, 6, 3}, {2, -4, 2}, {0, 8, 3}});
+    Matrix<int> b({{-3, 4, 0}, {1, -5, 4}, {2, 0, 0}});
+    Matrix<int> res({{9, -26, 24}, {-6, 28, -16}, {14, -40, 32}});
+
+    EXPECT_TRUE(res == s_fast::SharedMemoryMultiplication(a, b, 2));
+}
+
+TEST(SharedMemoryMultTest, StressTest) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    Matrix<double> a = Random<double>(75, 41, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<double> b = Random<double>(41, 60, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<double> expected = s_fast::SimpleMultiplication(a, b);
+
+    for (int processes : {1, 3}) {
+        EXPECT_TRUE(expected == s_fast::SharedMemoryMultiplication(a, b, processes, 16));
+    }
+}
@@ -57,3 +57,19 @@ TEST_F(SimdMultTest, StressTest) {
         EXPECT_TRUE(s_fast::SimpleMultiplication(a, b) == s_fast::SimdMultiplication(a, b));
     }
 }
+
+TEST_F(SimdMultTest, TransposedOperand) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using s_fast::SimpleMultiplication;
+    using s_fast::Transpose;
+    using s_fast::TransposedView;
+
+    Matrix<int> x = Random<int>(RowsL(), 37, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> y = Random<int>(RowsL(), 23, std::uniform_int_distribution<int>(-5, 5));
+
+    EXPECT_TRUE(SimpleMultiplication(x, Transpose(x)) ==
+                s_fast::SimdMultiplication(x, TransposedView(x)));
+    EXPECT_TRUE(SimpleMultiplication(Transpose(x), y) ==
+                s_fast::SimdMultiplication(TransposedView(x), y));
+}
@@ -27,3 +27,16 @@ TEST(SimpleMultWithTransposeTest, Correctness3x3) {
 
     EXPECT_TRUE(res == return_val);
 }
+
+TEST(SimpleMultWithTransposeTest, TransposedOperand) {
+    using s_fast::Matrix;
+
+    Matrix<int> a({{1, 6, 3}, {2, -4, 2}, {0, 8, 3}});
+    Matrix<int> b_t({{-3, 1, 2}, {4, -5, 0}, {0, 4, 0}});
+    Matrix<int> res({{9, -26, 24}, {-6, 28, -16}, {14, -40, 32}});
+
+    Matrix<int> return_val =
+        s_fast::SimpleMultiplicationWithTranspose(a, s_fast::TransposedView(b_t));
+
+    EXPECT_TRUE(res == return_val);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/cache_oblivious_multpiplication.h"
+#include "../src/simple_multiplication.h"
+#include "../src/skinny_multiplication.h"
+#include "../src/strassen.h"
+
+TEST(SkinnyMultTest, TallSkinny) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    s_fast::ThreadPool pool(3);
+
+    for (int64_t columns : {1, 7, 32, 45}) {
+        Matrix<double> a = Random<double>(3001, 32, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<double> b = Random<double>(32, columns, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<double> expected = s_fast::SimpleMultiplication(a, b);
+
+        EXPECT_TRUE(expected == s_fast::TallSkinnyMultiplication(a, b));
+        EXPECT_TRUE(expected == s_fast::TallSkinnyMultiplication(a, b, &pool));
+    }
+}
+
+TEST(SkinnyMultTest, SplitK) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    s_fast::ThreadPool pool(3);
+
+    for (int64_t inner : {1, 255, 4099}) {
+        Matrix<double> a = Random<double>(13, inner, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<double> b = Random<double>(inner, 21, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<double> expected = s_fast::SimpleMultiplication(a, b);
+
+        EXPECT_TRUE(expected == s_fast::SplitKMultiplication(a, b));
+        EXPECT_TRUE(expected == s_fast::SplitKMultiplication(a, b, &pool));
+    }
+}
+
+//  Skewed shapes at the top level and, for 4097 x 131 times 131 x 20, in padded blocks one level
+//  down the recursion.
+TEST(SkinnyMultTest, Dispatch) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    struct Shape {
+        int64_t rows;
+        int64_t inner;
+        int64_t columns;
+    };
+
+    for (Shape shape : {Shape{4000, 100, 40}, Shape{20, 5000, 30}, Shape{4097, 131, 20}}) {
+        Matrix<int> a =
+            Random<int>(shape.rows, shape.inner, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<int> b =
+            Random<int>(shape.inner, shape.columns, std::uniform_int_distribution<int>(-5, 5));
+        Matrix<int> expected = s_fast::SimpleMultiplication(a, b);
+
+        EXPECT_TRUE(expected == s_fast::Strassen(a, b));
+        EXPECT_TRUE(expected == s_fast::CacheObliviousMult(a, b));
+    }
+}
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <chrono>
 #include <random>
+#include <tuple>
 
 #include "../src/strassen.h"
 #include "../src/simple_multiplication.h"
@@ -59,3 +60,40 @@ TEST_F(StrassenTest, StressTest) {
         EXPECT_TRUE(s_fast::SimpleMultiplication(a, b) == s_fast::Strassen(a, b));
     }
 }
+
+TEST_F(StrassenTest, OddMultiLevelShapes) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    //  Odd sizes on several recursion levels, so padded quadrants of padded quadrants occur.
+    for (auto [n, m, k] : {std::tuple<Index, Index, Index>{100, 67, 131}, {257, 129, 255}}) {
+        Matrix<int> a = Random<int>(n, m, std::uniform_int_distribution<int>(-3, 3));
+        Matrix<int> b = Random<int>(m, k, std::uniform_int_distribution<int>(-3, 3));
+
+        EXPECT_TRUE(s_fast::SimpleMultiplication(a, b) == s_fast::Strassen(a, b));
+    }
+}
+
+TEST_F(StrassenTest, SubViewOperands) {
+    using s_fast::ConstViewMatrix;
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    //  Operands cut from the middle of larger matrices: their padding must read as zero, not as
+    //  the neighbouring elements.
+    Matrix<int> a_large = Random<int>(130, 90, std::uniform_int_distribution<int>(-3, 3));
+    Matrix<int> b_large = Random<int>(90, 150, std::uniform_int_distribution<int>(-3, 3));
+    ConstViewMatrix<int> a(a_large, {9, 11}, {9 + 101, 11 + 67});
+    ConstViewMatrix<int> b(b_large, {3, 2}, {3 + 67, 2 + 131});
+    Matrix<int> a_copy = s_fast::GetMatrix(a);
+    Matrix<int> b_copy = s_fast::GetMatrix(b);
+    Matrix<int> expected = s_fast::SimpleMultiplication(a_copy, b_copy);
+
+    EXPECT_TRUE(expected == s_fast::Strassen(a, b_copy));
+    EXPECT_TRUE(expected == s_fast::Strassen(a_copy, b));
+
+    Matrix<int> result(101, 131);
+    s_fast::ViewMatrix<int> result_view(result);
+    s_fast::detail_strassen::Strassen(a, b, result_view);
+    EXPECT_TRUE(expected == result);
+}
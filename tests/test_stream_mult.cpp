@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include "../src/simple_multiplication.h"
+#include "../src/stream_multiplication.h"
+
+namespace {
+
+using s_fast::Matrix;
+
+//  Serves rows of a matrix in blocks of growing size.
+class BlockReader {
+public:
+    explicit BlockReader(const Matrix<int>& matrix) : matrix_(matrix) {
+    }
+
+    bool operator()(Matrix<int>* block) {
+        if (row_ == matrix_.Rows()) {
+            return false;
+        }
+
+        int64_t rows = std::min(matrix_.Rows() - row_, ++block_rows_);
+        block->Reset(rows, matrix_.Columns());
+        for (int64_t row = 0; row < rows; ++row) {
+            for (int64_t column = 0; column < matrix_.Columns(); ++column) {
+                (*block)(row, column) = matrix_(row_ + row, column);
+            }
+        }
+
+        row_ += rows;
+        return true;
+    }
+
+private:
+    const Matrix<int>& matrix_;
+    int64_t row_ = 0;
+    int64_t block_rows_ = 0;
+};
+
+}  // namespace
+
+TEST(StreamMultTest, StressTest) {
+    using s_fast::Random;
+
+    Matrix<int> a = Random<int>(500, 23, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> b = Random<int>(23, 37, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> expected = s_fast::SimpleMultiplication(a, b);
+
+    s_fast::ThreadPool pool(2);
+
+    for (s_fast::Executor* executor : {static_cast<s_fast::Executor*>(nullptr),
+                                       static_cast<s_fast::Executor*>(&pool)}) {
+        Matrix<int> result(a.Rows(), b.Columns());
+        int64_t row = 0;
+
+        s_fast::MultiplyStream(
+            BlockReader(a), b,
+            [&](const Matrix<int>& block) {
+                for (int64_t i = 0; i < block.Rows(); ++i, ++row) {
+                    for (int64_t column = 0; column < block.Columns(); ++column) {
+                        result(row, column) = block(i, column);
+                    }
+                }
+            },
+            executor);
+
+        EXPECT_EQ(row, a.Rows());
+        EXPECT_TRUE(expected == result);
+    }
+}
+
+TEST(StreamMultTest, Exceptions) {
+    Matrix<int> b(3, 3);
+    s_fast::ThreadPool pool(2);
+
+    for (s_fast::Executor* executor : {static_cast<s_fast::Executor*>(nullptr),
+                                       static_cast<s_fast::Executor*>(&pool)}) {
+        auto failing_reader = [](Matrix<int>*) -> bool { throw std::runtime_error("read"); };
+        EXPECT_THROW(
+            s_fast::MultiplyStream(failing_reader, b, [](const Matrix<int>&) {}, executor),
+            std::runtime_error);
+
+        //  Fails on the second block, while the first one is being multiplied.
+        int reads = 0;
+        auto late_failing_reader = [&](Matrix<int>* block) {
+            if (reads++ == 1) {
+                throw std::runtime_error("read");
+            }
+            block->Reset(200, 3);
+            return true;
+        };
+        EXPECT_THROW(
+            s_fast::MultiplyStream(late_failing_reader, b, [](const Matrix<int>&) {}, executor),
+            std::runtime_error);
+
+        auto endless_reader = [](Matrix<int>* block) {
+            block->Reset(2, 3);
+            return true;
+        };
+        EXPECT_THROW(s_fast::MultiplyStream(
+                         endless_reader, b,
+                         [](const Matrix<int>&) { throw std::logic_error("sink"); }, executor),
+                     std::logic_error);
+    }
+}
+
+TEST(StreamMultTest, ReadsOnCallingThread) {
+    using s_fast::Random;
+
+    Matrix<int> a = Random<int>(300, 10, std::uniform_int_distribution<int>(-5, 5));
+    Matrix<int> b = Random<int>(10, 10, std::uniform_int_distribution<int>(-5, 5));
+    s_fast::ThreadPool pool(2);
+    std::thread::id caller = std::this_thread::get_id();
+    BlockReader blocks(a);
+
+    s_fast::MultiplyStream(
+        [&](Matrix<int>* block) {
+            EXPECT_EQ(std::this_thread::get_id(), caller);
+            return blocks(block);
+        },
+        b, [](const Matrix<int>&) {}, &pool);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/simple_multiplication.h"
+#include "../src/symmetric_multiplication.h"
+
+namespace {
+
+s_fast::Matrix<int> KeepTriangle(s_fast::Matrix<int> matrix, s_fast::Triangle triangle) {
+    using Index = s_fast::Matrix<int>::Index;
+
+    for (Index i = 0; i < matrix.Rows(); ++i) {
+        for (Index j = 0; j < matrix.Columns(); ++j) {
+            if (triangle == s_fast::Triangle::kLower ? j > i : j < i) {
+                matrix(i, j) = 0;
+            }
+        }
+    }
+    return matrix;
+}
+
+}  // namespace
+
+TEST(SymmetricMultTest, Syrk) {
+    using s_fast::Gram;
+    using s_fast::Matrix;
+    using s_fast::SimpleMultiplication;
+    using s_fast::Transpose;
+    using s_fast::Triangle;
+
+    Matrix<int> a = s_fast::Random<int>(70, 45, std::uniform_int_distribution<int>(-4, 4));
+    Matrix<int> rows = SimpleMultiplication(a, Transpose(a));
+    Matrix<int> columns = SimpleMultiplication(Transpose(a), a);
+
+    for (Triangle triangle : {Triangle::kLower, Triangle::kUpper}) {
+        EXPECT_TRUE(KeepTriangle(rows, triangle) == s_fast::Syrk(a, Gram::kRows, triangle));
+        EXPECT_TRUE(KeepTriangle(columns, triangle) == s_fast::Syrk(a, Gram::kColumns, triangle));
+
+        Matrix<int> full = s_fast::Syrk(a, Gram::kRows, triangle);
+        s_fast::Symmetrize(&full, triangle);
+        EXPECT_TRUE(rows == full);
+    }
+}
+
+TEST(SymmetricMultTest, Trmm) {
+    using s_fast::Matrix;
+    using s_fast::Triangle;
+
+    Matrix<int> a = s_fast::Random<int>(40, 40, std::uniform_int_distribution<int>(-4, 4));
+    Matrix<int> b = s_fast::Random<int>(40, 23, std::uniform_int_distribution<int>(-4, 4));
+
+    for (Triangle triangle : {Triangle::kLower, Triangle::kUpper}) {
+        EXPECT_TRUE(s_fast::SimpleMultiplication(KeepTriangle(a, triangle), b) ==
+                    s_fast::Trmm(a, triangle, b));
+    }
+}
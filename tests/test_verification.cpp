@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "../src/modular.h"
+#include "../src/simd_multiplication.h"
+#include "../src/strassen.h"
+#include "../src/verification.h"
+
+TEST(VerificationTest, FloatingPoint) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    s_fast::ThreadPool pool(2);
+
+    Matrix<double> a = Random<double>(150, 90, std::uniform_real_distribution<double>(-1, 1));
+    Matrix<double> b = Random<double>(90, 120, std::uniform_real_distribution<double>(-1, 1));
+    Matrix<double> c = s_fast::Strassen(a, b);
+
+    EXPECT_TRUE(s_fast::Verify(a, b, c));
+    EXPECT_TRUE(s_fast::Verify(a, b, c, 4, 0, &pool));
+
+    c(17, 33) += 1e-6;
+    EXPECT_FALSE(s_fast::Verify(a, b, c));
+    EXPECT_FALSE(s_fast::Verify(a, b, c, 4, 0, &pool));
+    EXPECT_FALSE(s_fast::Verify(a, b, Matrix<double>(150, 121)));
+}
+
+TEST(VerificationTest, Exact) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using Mod = s_fast::ModInt<998244353>;
+
+    Matrix<int> a = Random<int>(70, 40, std::uniform_int_distribution<int>(-9, 9));
+    Matrix<int> b = Random<int>(40, 50, std::uniform_int_distribution<int>(-9, 9));
+    Matrix<int> c = s_fast::SimdMultiplication(a, b);
+
+    //  A single wrong element is missed by a trial whenever its x entry is 0, so the failing checks
+    //  run enough trials to make that negligible.
+    EXPECT_TRUE(s_fast::Verify(a, b, c));
+    c(69, 0) ^= 1 << 12;
+    EXPECT_FALSE(s_fast::Verify(a, b, c, 40));
+
+    Matrix<Mod> x = Random<Mod>(30, 30, std::uniform_int_distribution<int>(0, 998244352));
+    Matrix<Mod> y = s_fast::SimdMultiplication(x, x);
+    EXPECT_TRUE(s_fast::Verify(x, x, y));
+    y(3, 3) += 1;
+    EXPECT_FALSE(s_fast::Verify(x, x, y, 40));
+}
+
+TEST(VerificationTest, ErrorsCancellingForSignVectors) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+    using Bit = s_fast::ModInt<2>;
+
+    //  Both errors cancel in c * x for every x with entries +-1, so only {0, 1} entries catch them.
+    Matrix<Bit> x = Random<Bit>(20, 20, std::uniform_int_distribution<int>(0, 1));
+    Matrix<Bit> y = s_fast::SimdMultiplication(x, x);
+    EXPECT_TRUE(s_fast::Verify(x, x, y));
+    y(5, 3) += 1;
+    y(5, 7) += 1;
+    EXPECT_FALSE(s_fast::Verify(x, x, y, 40));
+
+    Matrix<uint32_t> a = Random<uint32_t>(30, 20, std::uniform_int_distribution<uint32_t>());
+    Matrix<uint32_t> b = Random<uint32_t>(20, 25, std::uniform_int_distribution<uint32_t>());
+    Matrix<uint32_t> c = s_fast::SimdMultiplication(a, b);
+    EXPECT_TRUE(s_fast::Verify(a, b, c));
+    c(11, 2) += 1u << 31;
+    c(11, 20) += 1u << 31;
+    EXPECT_FALSE(s_fast::Verify(a, b, c, 40));
+}
+
+TEST(VerificationTest, VerifiedEngine) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    Matrix<float> a = Random<float>(64, 64, std::uniform_real_distribution<float>(-1, 1));
+
+    auto strassen = s_fast::Verified([](const auto& x, const auto& y) {
+        return s_fast::Strassen(x, y);
+    });
+    EXPECT_TRUE(s_fast::Verify(a, a, strassen(a, a)));
+
+    auto broken = s_fast::Verified([](const auto& x, const auto& y) {
+        Matrix<float> product = s_fast::SimdMultiplication(x, y);
+        product(0, 0) = -product(0, 0) + 1;
+        return product;
+    });
+    EXPECT_THROW(broken(a, a), s_fast::VerificationError);
+}
+
+TEST(VerificationTest, VerifiedStrassenOnScaledRows) {
+    using s_fast::Matrix;
+    using s_fast::Random;
+
+    auto strassen = s_fast::Verified([](const auto& x, const auto& y) {
+        return s_fast::Strassen(x, y);
+    });
+
+    for (int64_t n : {64, 256, 512}) {
+        for (uint32_t seed = 1; seed <= 3; ++seed) {
+            Matrix<double> a =
+                Random<double>(n, n, std::uniform_real_distribution<double>(-1, 1), seed);
+            Matrix<double> b =
+                Random<double>(n, n, std::uniform_real_distribution<double>(-1, 1), seed + 10);
+            //  Strassen gives the small rows errors of the size of the large ones.
+            for (int64_t row = 0; row < n / 2; ++row) {
+                for (int64_t column = 0; column < n; ++column) {
+                    a(row, column) *= 1e-12;
+                }
+            }
+
+            EXPECT_NO_THROW(strassen(a, b));
+        }
+    }
+}
@@ -120,3 +120,25 @@ TEST(ViewMatrixCorrection, GetMatrix) {
 
     EXPECT_TRUE(a_copy == a);
 }
+
+TEST(ViewMatrixCorrection, TransposedView) {
+    using s_fast::ConstViewMatrix;
+    using s_fast::Matrix;
+    using Index = Matrix<int>::Index;
+
+    Matrix<int> a({{1, 2, 3}, {4, 5, 6}});
+    auto a_t = s_fast::TransposedView(a);
+    EXPECT_EQ(a_t.Rows(), 3);
+    EXPECT_EQ(a_t.Columns(), 2);
+
+    for (Index i = 0; i < a_t.Rows(); ++i) {
+        for (Index j = 0; j < a_t.Columns(); ++j) {
+            EXPECT_EQ(a_t(i, j), a(j, i));
+        }
+    }
+
+    auto sub_t = s_fast::TransposedView(ConstViewMatrix<int>(a, {0, 1}, {2, 3}));
+    EXPECT_EQ(sub_t(1, 1), 6);
+    EXPECT_EQ(sub_t.Base().Stride(), 3);
+    EXPECT_EQ(*sub_t.Base().Data(), 2);
+}